@@ -0,0 +1,152 @@
+// Counts the copies of the values sent to several local consumers: on every rank a number of tiles is each sent to a
+// number of readers, whose input is read-only, and a number of writers, which update their input. The tiles are
+// sent by value (the producer moves each tile into the send) and by reference (the producer keeps each tile). Without
+// sharing every consumer would get its own copy of a tile, except the one consumer that a moved tile is moved into;
+// with shared values (MADNESS only, see ttg_madness::detail::data_copy) the readers share a single copy of a tile and
+// a writer copies the tile only if it still shares it when it executes.
+//
+// Usage: copies [number of tiles per rank] [number of readers] [number of writers] [number of repetitions]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "ttg.h"
+#include "ttg/serialization/std/vector.h"
+
+using namespace ttg;
+
+/// a tile that counts how often tiles are copied
+class Tile {
+  std::vector<double> data_;
+
+ public:
+  static inline std::atomic<std::uint64_t> ncopies = 0;
+
+  Tile() = default;
+  explicit Tile(std::size_t n) : data_(n, 1.0) {}
+  Tile(const Tile &other) : data_(other.data_) { ++ncopies; }
+  Tile(Tile &&other) = default;
+  Tile &operator=(const Tile &other) {
+    data_ = other.data_;
+    ++ncopies;
+    return *this;
+  }
+  Tile &operator=(Tile &&other) = default;
+
+  double sum() const { return std::accumulate(data_.begin(), data_.end(), 0.0); }
+  void scale(double factor) {
+    for (auto &x : data_) x *= factor;
+  }
+
+#ifdef TTG_SERIALIZATION_SUPPORTS_MADNESS
+  template <typename Archive>
+  void serialize(Archive &ar) {
+    ar &data_;
+  }
+#endif
+
+#ifdef TTG_SERIALIZATION_SUPPORTS_BOOST
+  template <typename Archive>
+  void serialize(Archive &ar, const unsigned int) {
+    ar &data_;
+  }
+#endif
+};
+
+/// @return the number of copies made on this rank to send \p ntiles tiles per rank to \p nreaders readers and
+///         \p nwriters writers each
+std::uint64_t count_copies(int ntiles, int nreaders, int nwriters, bool move) {
+  auto world = ttg_default_execution_context();
+  const int rank = world.rank();
+  auto keymap = [ntiles](const int &t) { return t / ntiles; };
+
+  Edge<int, Tile> tiles("tiles");
+
+  auto start = wrap<int>(
+      [ntiles, move](const int &r, std::tuple<Out<int, Tile>> &out) {
+        for (int t = r * ntiles; t != (r + 1) * ntiles; ++t) {
+          Tile tile(1024);
+          if (move)
+            send<0>(t, std::move(tile), out);
+          else
+            send<0>(t, tile, out);
+        }
+      },
+      edges(), edges(tiles), "start", {}, {"tiles"});
+  start->set_keymap([](const int &r) { return r; });
+
+  auto make_reader = [&]() {
+    auto reader = wrap(
+        [](const int &t, const Tile &tile, std::tuple<> &out) {
+          if (tile.sum() != 1024) throw std::runtime_error("copies: a reader got a modified tile");
+        },
+        edges(tiles), edges(), "reader", {"tiles"}, {});
+    reader->set_keymap(keymap);
+    return reader;
+  };
+  std::vector<decltype(make_reader())> readers;
+  for (int r = 0; r != nreaders; ++r) readers.push_back(make_reader());
+
+  auto make_writer = [&]() {
+    auto writer = wrap(
+        [](const int &t, Tile &tile, std::tuple<> &out) {
+          if (tile.sum() != 1024) throw std::runtime_error("copies: a writer got a modified tile");
+          tile.scale(2.0);
+        },
+        edges(tiles), edges(), "writer", {"tiles"}, {});
+    writer->set_keymap(keymap);
+    return writer;
+  };
+  std::vector<decltype(make_writer())> writers;
+  for (int w = 0; w != nwriters; ++w) writers.push_back(make_writer());
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  const std::uint64_t ncopies = Tile::ncopies;
+  start->invoke(rank);
+  ttg_fence(world);
+  return Tile::ncopies - ncopies;
+}
+
+int main(int argc, char **argv) {
+  const int ntiles = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int nreaders = argc > 2 ? std::atoi(argv[2]) : 4;
+  const int nwriters = argc > 3 ? std::atoi(argv[3]) : 2;
+  const int nreps = argc > 4 ? std::atoi(argv[4]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+  auto world = ttg_default_execution_context();
+
+  for (const bool move : {true, false}) {
+    // copies per tile without sharing: one per consumer, but for the consumer that a moved tile is moved into
+    const std::uint64_t unshared = nreaders + nwriters - (move && nreaders + nwriters > 0 ? 1 : 0);
+    // copies per tile with sharing: one shared copy of a tile that is not moved, and one per writer at most
+    const std::uint64_t shared = (!move && nreaders + nwriters > 0 ? 1 : 0) + nwriters;
+    for (int rep = 0; rep != nreps; ++rep) {
+      const auto ncopies = ttg_allreduce(world, count_copies(ntiles, nreaders, nwriters, move)).get();
+      const std::uint64_t ntotal = static_cast<std::uint64_t>(ntiles) * world.size();
+#if defined(TTG_USE_MADNESS)
+      if (ncopies > shared * ntotal)
+        throw std::runtime_error("copies: " + std::to_string(ncopies) + " copies, expected at most " +
+                                 std::to_string(shared * ntotal));
+#endif
+      if (world.rank() == 0)
+        std::cout << "copies: tiles sent by " << (move ? "value" : "reference") << ": "
+                  << static_cast<double>(ncopies) / ntotal << " copies per tile (without sharing: " << unshared
+                  << ")" << std::endl;
+    }
+  }
+
+  ttg_fence(world);
+  ttg_finalize();
+  return 0;
+}
@@ -0,0 +1,68 @@
+// Measures the latency of ttg_fence, as paid by iterative applications that fence after every step: every step
+// executes a graph in which each rank sends a message to the next rank, followed by a fence. Steps with no tasks at
+// all measure the cost of the fence alone.
+//
+// Usage: fence [number of steps] [number of repetitions]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// @return the average time per step of \p nsteps steps, in seconds
+double fence_latency(int nsteps, bool empty) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+
+  Edge<int, int> ring("ring");
+
+  auto start = wrap<int>(
+      [nranks](const int &r, std::tuple<Out<int, int>> &out) { send<0>((r + 1) % nranks, r, out); }, edges(),
+      edges(ring), "start", {}, {"ring"});
+  start->set_keymap([](const int &r) { return r; });
+
+  auto receive = wrap(
+      [nranks](const int &r, const int &from, std::tuple<> &out) {
+        if ((from + 1) % nranks != r) throw std::runtime_error("fence: received message from the wrong rank");
+      },
+      edges(ring), edges(), "receive", {"ring"}, {});
+  receive->set_keymap([](const int &r) { return r; });
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  auto beg = std::chrono::high_resolution_clock::now();
+  for (int step = 0; step != nsteps; ++step) {
+    if (!empty) start->invoke(world.rank());
+    ttg_fence(world);
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6 / nsteps;
+}
+
+int main(int argc, char **argv) {
+  const int nsteps = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int nreps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  for (const bool empty : {true, false}) {
+    for (int rep = 0; rep != nreps; ++rep) {
+      const double seconds = fence_latency(nsteps, empty);
+      if (ttg_default_execution_context().rank() == 0)
+        std::cout << "fence: " << (empty ? "empty" : "ring") << " step on " << ttg_default_execution_context().size()
+                  << " ranks: " << seconds * 1e6 << " us" << std::endl;
+    }
+  }
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
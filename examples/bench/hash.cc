@@ -0,0 +1,108 @@
+// Compares the throughput of the default ttg::hash against the byte-wise FNV hasher (the previous default)
+// on the key types used by the examples. The keys are reproduced here without their hand-written hash() members,
+// i.e. as they would be hashed by the default ttg::hash.
+//
+// Usage: hash-bench [number of keys] [number of repetitions]
+
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ttg/util/hash.h"
+
+namespace spmm {
+  // spmm's Key<Rank>
+  template <std::size_t Rank>
+  using Key = std::array<long, Rank>;
+}  // namespace spmm
+
+namespace potrf {
+  // potrf's Key1/Key2/Key3 (sans the cached hash value)
+  struct Key1 {
+    int K;
+  };
+  struct Key2 {
+    int I, J;
+  };
+  struct Key3 {
+    int I, J, K;
+  };
+}  // namespace potrf
+
+namespace t9 {
+  // t9's Key (sans the cached hash value): level and translation
+  using Key = std::pair<int, unsigned long>;
+}  // namespace t9
+
+template <typename Key>
+struct fnv_hash {
+  std::size_t operator()(const Key &key) const {
+    ttg::detail::FNVhasher hasher;
+    hasher.update(sizeof(Key), reinterpret_cast<const std::byte *>(&key));
+    return hasher.value();
+  }
+};
+
+/// @return {time per hash in ns, number of distinct hash values}
+template <typename Key, typename Hasher>
+std::pair<double, std::size_t> measure(const std::vector<Key> &keys, int nreps) {
+  const Hasher hasher;
+  std::size_t sum = 0;  // keeps the optimizer from removing the loop
+  auto beg = std::chrono::high_resolution_clock::now();
+  for (int r = 0; r != nreps; ++r)
+    for (const auto &key : keys) sum += hasher(key);
+  auto end = std::chrono::high_resolution_clock::now();
+  std::unordered_set<std::size_t> distinct;
+  for (const auto &key : keys) distinct.insert(hasher(key));
+  if (sum == 1) std::cout << "";
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - beg).count();
+  return {static_cast<double>(ns) / (keys.size() * nreps), distinct.size()};
+}
+
+template <typename Key>
+void report(const std::string &name, const std::vector<Key> &keys, int nreps) {
+  auto [fnv_ns, fnv_distinct] = measure<Key, fnv_hash<Key>>(keys, nreps);
+  auto [ttg_ns, ttg_distinct] = measure<Key, ttg::hash<Key>>(keys, nreps);
+  std::cout << name << " (" << sizeof(Key) << " bytes): FNV " << fnv_ns << " ns/hash (" << fnv_distinct
+            << " distinct), ttg::hash " << ttg_ns << " ns/hash (" << ttg_distinct << " distinct), speedup "
+            << fnv_ns / ttg_ns << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  const long nkeys = argc > 1 ? std::atol(argv[1]) : 1 << 20;
+  const int nreps = argc > 2 ? std::atoi(argv[2]) : 10;
+  const long n = std::max(1l, static_cast<long>(std::cbrt(nkeys)));
+
+  std::vector<spmm::Key<2>> spmm_key2;
+  std::vector<spmm::Key<3>> spmm_key3;
+  std::vector<potrf::Key1> potrf_key1;
+  std::vector<potrf::Key2> potrf_key2;
+  std::vector<potrf::Key3> potrf_key3;
+  std::vector<t9::Key> t9_key;
+  for (long i = 0; i != nkeys; ++i) {
+    spmm_key2.push_back({i / (n * n), i % (n * n)});
+    spmm_key3.push_back({i / (n * n), (i / n) % n, i % n});
+    potrf_key1.push_back({static_cast<int>(i)});
+    potrf_key2.push_back({static_cast<int>(i / (n * n)), static_cast<int>(i % (n * n))});
+    potrf_key3.push_back({static_cast<int>(i / (n * n)), static_cast<int>((i / n) % n), static_cast<int>(i % n)});
+    const int level = 63 - __builtin_clzl(i + 1);
+    t9_key.push_back({level, static_cast<unsigned long>(i + 1 - (1l << level))});
+  }
+
+  report("spmm Key<2>", spmm_key2, nreps);
+  report("spmm Key<3>", spmm_key3, nreps);
+  report("potrf Key1", potrf_key1, nreps);
+  report("potrf Key2", potrf_key2, nreps);
+  report("potrf Key3", potrf_key3, nreps);
+  report("t9 Key", t9_key, nreps);
+
+  return 0;
+}
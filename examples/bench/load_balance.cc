@@ -0,0 +1,91 @@
+// Measures the effect of migrating tasks between ranks on a deliberately skewed workload: the keymap places all tasks
+// on rank 0. Every task waits for two inputs, a value that is sent to all tasks up front and a token that is passed
+// along one of a number of chains of tasks, hence most tasks wait for their token while the tasks at the heads of the
+// chains run. Without migration rank 0 executes every task; with migration (see Op::set_key_migration) rank 0 hands
+// waiting tasks over to the idle ranks.
+//
+// Usage: load-balance [number of tasks] [number of chains] [microseconds per task] [number of repetitions]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// spins for \p us microseconds
+void work(int us) {
+  const auto end = std::chrono::high_resolution_clock::now() + std::chrono::microseconds(us);
+  while (std::chrono::high_resolution_clock::now() < end)
+    ;
+}
+
+/// @return the time to execute \p ntasks tasks, in seconds
+double skewed_chains(int ntasks, int nchains, int us, bool migrate) {
+  auto world = ttg_default_execution_context();
+  Edge<int, double> values("values");
+  Edge<int, int> tokens("tokens");
+  std::atomic<std::uint64_t> nexecuted = 0;  // # of tasks executed on this rank
+
+  auto start = wrap<int>(
+      [ntasks, nchains](const int &, std::tuple<Out<int, double>, Out<int, int>> &out) {
+        for (int t = 0; t != ntasks; ++t) send<0>(t, 1.0, out);
+        for (int c = 0; c != nchains; ++c) send<1>(c, 0, out);
+      },
+      edges(), edges(values, tokens), "start", {}, {"values", "tokens"});
+  start->set_keymap([](const int &) { return 0; });
+
+  auto chain = wrap(
+      [&nexecuted, ntasks, nchains, us](const int &t, const double &value, const int &token,
+                                        std::tuple<Out<int, int>> &out) {
+        work(us);
+        ++nexecuted;
+        if (t + nchains < ntasks) send<0>(t + nchains, token + 1, out);
+      },
+      edges(values, tokens), edges(tokens), "chain", {"values", "tokens"}, {"tokens"});
+  chain->set_keymap([](const int &) { return 0; });
+  chain->set_key_migration(migrate);
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  auto beg = std::chrono::high_resolution_clock::now();
+  if (world.rank() == 0) start->invoke(0);
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  if (ttg_allreduce(world, nexecuted.load()).get() != static_cast<std::uint64_t>(ntasks))
+    throw std::runtime_error("load-balance: wrong number of tasks executed");
+  if (migrate)
+    std::cout << "load-balance: rank " << world.rank() << " executed " << nexecuted.load() << " tasks" << std::endl;
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+}
+
+int main(int argc, char **argv) {
+  const int ntasks = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int nchains = argc > 2 ? std::atoi(argv[2]) : 64;
+  const int us = argc > 3 ? std::atoi(argv[3]) : 100;
+  const int nreps = argc > 4 ? std::atoi(argv[4]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  for (const bool migrate : {false, true}) {
+    for (int rep = 0; rep != nreps; ++rep) {
+      const double seconds = skewed_chains(ntasks, nchains, us, migrate);
+      if (ttg_default_execution_context().rank() == 0)
+        std::cout << "load-balance: " << (migrate ? "with" : "without") << " migration: " << seconds << " s"
+                  << std::endl;
+    }
+  }
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
@@ -0,0 +1,108 @@
+// Measures the rate of remote sends of small values: every rank sends N values to the op instances owned by its
+// neighbor rank (on a single rank all sends are local).
+//
+// Usage: message-rate [number of messages per rank] [number of repetitions] [aggregate]
+// "aggregate" enables coalescing of remote messages (PaRSEC backend only); with the PaRSEC backend the number of
+// active messages sent per message is reported as well, to show the reduction achieved by coalescing
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// @return the rate of messages received, in msgs/s; \p ams_per_msg is set to the number of active messages sent per
+///         message sent by the ranks, or to -1 if the backend does not count them
+template <typename Value>
+double message_rate(std::int64_t nmsgs, double &ams_per_msg) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+  const int rank = world.rank();
+
+  Edge<std::int64_t, Value> msgs("msgs");
+  auto start = wrap<int>(
+      [nmsgs](const int &r, std::tuple<Out<std::int64_t, Value>> &out) {
+        const Value value{};
+        for (std::int64_t i = 0; i != nmsgs; ++i) send<0>(r * nmsgs + i, value, out);
+      },
+      edges(), edges(msgs), "start", {}, {"msgs"});
+  start->set_keymap([](const int &r) { return r; });
+
+  std::atomic<std::int64_t> nreceived = 0;
+  auto sink = wrap([&nreceived](const std::int64_t &key, const Value &value,
+                                std::tuple<> &out) { nreceived.fetch_add(1, std::memory_order_relaxed); },
+                   edges(msgs), edges(), "sink", {"msgs"}, {});
+  sink->set_keymap([nmsgs, nranks](const std::int64_t &key) { return (key / nmsgs + 1) % nranks; });
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+#if defined(TTG_USE_PARSEC)
+  const auto stats_beg = world.impl().msg_stats();
+#endif
+  auto beg = std::chrono::high_resolution_clock::now();
+  start->invoke(rank);
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+#if defined(TTG_USE_PARSEC)
+  const auto stats_end = world.impl().msg_stats();
+  double msgs_sent = stats_end[0] - stats_beg[0];
+  double ams_sent = stats_end[1] - stats_beg[1];
+  ttg_sum(world, msgs_sent);
+  ttg_sum(world, ams_sent);
+  ams_per_msg = msgs_sent > 0 ? ams_sent / msgs_sent : 0;
+#else
+  ams_per_msg = -1;
+#endif
+
+  double nreceived_total = nreceived.load();
+  ttg_sum(world, nreceived_total);
+  if (nreceived_total != static_cast<double>(nmsgs) * nranks)
+    throw std::runtime_error("message-rate: received " + std::to_string(nreceived_total) + " messages, expected " +
+                             std::to_string(nmsgs * nranks));
+  const double seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+  return nreceived_total / seconds;
+}
+
+template <typename Value>
+void report(const std::string &label, std::int64_t nmsgs, int nreps) {
+  for (int rep = 0; rep != nreps; ++rep) {
+    double ams_per_msg;
+    const double rate = message_rate<Value>(nmsgs, ams_per_msg);
+    if (ttg_default_execution_context().rank() == 0) {
+      std::cout << "message-rate: " << label << " (" << sizeof(Value) << " bytes): " << rate << " msgs/s";
+      if (ams_per_msg >= 0) std::cout << ", " << ams_per_msg << " active messages/msg";
+      std::cout << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  const std::int64_t nmsgs = argc > 1 ? std::atol(argv[1]) : 100000;
+  const int nreps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  const bool aggregate = argc > 3 && std::string(argv[3]) == "aggregate";
+
+  ttg_initialize(argc, argv, -1);
+#if defined(TTG_USE_PARSEC)
+  ttg_default_execution_context().impl().set_msg_aggregation(aggregate);
+#else
+  if (aggregate) std::cerr << "message-rate: message aggregation is not supported by this backend" << std::endl;
+#endif
+  ttg_execute(ttg_default_execution_context());
+
+  report<std::int64_t>("int64_t", nmsgs, nreps);
+  report<std::array<char, 256>>("array<char,256>", nmsgs, nreps);
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
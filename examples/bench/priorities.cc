@@ -0,0 +1,93 @@
+// Measures the effect of task priorities on the time to solution of a graph with a critical path: a chain of tasks
+// each of which also spawns a number of filler tasks that are not on the critical path. With priorities the chain
+// tasks are executed ahead of the fillers, hence the chain does not wait behind them and the time to solution
+// approaches max(chain length, total work / number of threads).
+//
+// Usage: priorities [chain length] [number of fillers per chain task] [task duration in microseconds]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// spins for \p us microseconds
+static void work(int us) {
+  const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(us);
+  while (std::chrono::steady_clock::now() < end)
+    ;
+}
+
+/// @return time to solution in seconds
+double time_to_solution(int length, int nfillers, int duration_us, bool use_priorities) {
+  auto world = ttg_default_execution_context();
+
+  Edge<int, int> chain_e("chain"), filler_e("filler");
+  std::atomic<std::int64_t> nexecuted = 0;
+  auto chain = wrap(
+      [&nexecuted, length, nfillers, duration_us](const int &k, const int &v,
+                                                  std::tuple<Out<int, int>, Out<int, int>> &out) {
+        work(duration_us);
+        nexecuted.fetch_add(1, std::memory_order_relaxed);
+        if (k + 1 < length) send<0>(k + 1, 0, out);
+        for (int f = 0; f != nfillers; ++f) send<1>(k * nfillers + f, 0, out);
+      },
+      edges(chain_e), edges(chain_e, filler_e), "chain", {"chain"}, {"chain", "filler"});
+  auto filler = wrap(
+      [&nexecuted, duration_us](const int &key, const int &v, std::tuple<> &out) {
+        work(duration_us);
+        nexecuted.fetch_add(1, std::memory_order_relaxed);
+      },
+      edges(filler_e), edges(), "filler", {"filler"}, {});
+  if (use_priorities) {
+    // the earlier in the chain, the more work depends on a task
+    chain->set_priomap([length](const int &k) { return 2 * (length - k) + 1; });
+    filler->set_priomap([](const int &key) { return 1; });
+  } else {
+    chain->set_priomap([](const int &k) { return 0; });
+    filler->set_priomap([](const int &key) { return 0; });
+  }
+
+  auto connected = make_graph_executable(chain.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  auto beg = std::chrono::high_resolution_clock::now();
+  const int zero = 0;
+  if (chain->get_keymap()(0) == world.rank()) chain->invoke(0, std::tie(zero));
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  double nexecuted_total = nexecuted.load();
+  ttg_sum(world, nexecuted_total);
+  if (nexecuted_total != static_cast<double>(length) * (nfillers + 1))
+    throw std::runtime_error("priorities: executed " + std::to_string(nexecuted_total) + " tasks, expected " +
+                             std::to_string(length * (nfillers + 1)));
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+}
+
+int main(int argc, char **argv) {
+  const int length = argc > 1 ? std::atoi(argv[1]) : 100;
+  const int nfillers = argc > 2 ? std::atoi(argv[2]) : 16;
+  const int duration_us = argc > 3 ? std::atoi(argv[3]) : 100;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  for (bool use_priorities : {false, true}) {
+    const double seconds = time_to_solution(length, nfillers, duration_us, use_priorities);
+    if (ttg_default_execution_context().rank() == 0)
+      std::cout << "priorities: " << (use_priorities ? "on" : "off") << ": time to solution " << seconds << " s"
+                << std::endl;
+  }
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Measures the throughput of a high-fan-in streaming reduction: on every rank N producer tasks each send a tile to the
+// same key of a streaming input, which sums them. The reduction is timed with the default reducer, whose
+// contributions serialize on the task, with a commutative reducer, whose contributions are summed into per-thread
+// partial results, and (PaRSEC only) with an asynchronous reducer, whose contributions are queued and summed by
+// reduction tasks.
+//
+// Usage: stream-reduce [number of producers per rank] [number of repetitions]
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+using Tile = std::array<double, 512>;
+
+enum class Mode { Default, Commutative, Async };
+
+const char *to_string(Mode mode) {
+  switch (mode) {
+    case Mode::Default:
+      return "default";
+    case Mode::Commutative:
+      return "commutative";
+    case Mode::Async:
+      return "async";
+  }
+  return "";
+}
+
+/// @return the time to reduce \p nproducers tiles per rank, in seconds
+double stream_reduce(int nproducers, Mode mode) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+  const int nvalues = nproducers * nranks;
+
+  Edge<int, int> start_producers("start_producers");
+  Edge<int, Tile> tiles("tiles");
+
+  auto start = wrap<int>(
+      [nproducers](const int &r, std::tuple<Out<int, int>> &out) {
+        for (int p = 0; p != nproducers; ++p) send<0>(r * nproducers + p, 0, out);
+      },
+      edges(), edges(start_producers), "start", {}, {"start_producers"});
+  start->set_keymap([](const int &r) { return r; });
+
+  auto produce = wrap(
+      [](const int &p, const int &, std::tuple<Out<int, Tile>> &out) {
+        Tile tile;
+        tile.fill(1.0);
+        send<0>(0, std::move(tile), out);
+      },
+      edges(start_producers), edges(tiles), "produce", {"start_producers"}, {"tiles"});
+  produce->set_keymap([nproducers](const int &p) { return p / nproducers; });
+
+  auto sum = wrap(
+      [nvalues](const int &key, const Tile &tile, std::tuple<> &out) {
+        if (tile.front() != nvalues)
+          throw std::runtime_error("stream-reduce: wrong sum " + std::to_string(tile.front()) + ", expected " +
+                                   std::to_string(nvalues));
+      },
+      edges(tiles), edges(), "sum", {"tiles"}, {});
+  sum->set_keymap([](const int &key) { return 0; });
+  sum->set_input_reducer<0>(
+      [](Tile &&a, Tile &&b) {
+        for (std::size_t i = 0; i != a.size(); ++i) a[i] += b[i];
+        return std::move(a);
+      },
+      mode == Mode::Commutative);
+#if defined(TTG_USE_PARSEC)
+  if (mode == Mode::Async) sum->set_input_reducer_execution<0>(Execution::Async);
+#endif
+  sum->set_static_argstream_size<0>(nvalues);
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  auto beg = std::chrono::high_resolution_clock::now();
+  start->invoke(world.rank());
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+}
+
+int main(int argc, char **argv) {
+  const int nproducers = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int nreps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+#if defined(TTG_USE_PARSEC)
+  const auto modes = {Mode::Default, Mode::Commutative, Mode::Async};
+#else
+  const auto modes = {Mode::Default, Mode::Commutative};
+#endif
+  for (const Mode mode : modes) {
+    for (int rep = 0; rep != nreps; ++rep) {
+      const double seconds = stream_reduce(nproducers, mode);
+      if (ttg_default_execution_context().rank() == 0)
+        std::cout << "stream-reduce: " << to_string(mode) << " reducer: " << seconds << " s" << std::endl;
+    }
+  }
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Measures the allocation overhead of tasks in the MADNESS backend without the runtime: one thread creates tasks,
+// each with a cache entry that it erases once the task is ready (as set_arg does when the last argument arrives),
+// and hands the tasks to worker threads that delete them. Compares the tasks and cache entries allocated on the heap
+// (before object_pool), the tasks allocated from object_pool and the entries on the heap (the MADNESS backend),
+// and both allocated from object_pool.
+//
+// Usage: task-alloc-bench [number of tasks] [number of worker threads] [number of repetitions]
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ttg/madness/object_pool.h"
+
+/// stands in for OpArgs of an op with two inputs: the TaskInterface base, the input values and the counters
+struct task_data {
+  std::byte bytes[256];
+};
+
+/// stands in for an entry of madness::ConcurrentHashMap<std::int64_t, OpArgs *>
+struct entry_data {
+  std::int64_t key;
+  void *value;
+  entry_data *next;
+};
+
+template <typename T, bool pooled>
+struct alloc {
+  static void *allocate() {
+    if constexpr (pooled)
+      return ttg_madness::detail::object_pool<T>::allocate();
+    else
+      return ::operator new(sizeof(T));
+  }
+  static void deallocate(void *ptr) {
+    if constexpr (pooled)
+      ttg_madness::detail::object_pool<T>::deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+};
+
+/// batches of tasks handed from the creating thread to the workers
+class task_queue {
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::deque<std::vector<void *>> batches_;
+  bool done_ = false;
+
+ public:
+  void push(std::vector<void *> &&batch) {
+    {
+      std::scoped_lock lock(mtx_);
+      batches_.push_back(std::move(batch));
+    }
+    cv_.notify_one();
+  }
+  void close() {
+    {
+      std::scoped_lock lock(mtx_);
+      done_ = true;
+    }
+    cv_.notify_all();
+  }
+  /// @return false if the queue is closed and empty
+  bool pop(std::vector<void *> &batch) {
+    std::unique_lock lock(mtx_);
+    cv_.wait(lock, [this] { return done_ || !batches_.empty(); });
+    if (batches_.empty()) return false;
+    batch = std::move(batches_.front());
+    batches_.pop_front();
+    return true;
+  }
+};
+
+/// @return the time per task in ns
+template <bool pooled_tasks, bool pooled_entries>
+double measure(std::int64_t ntasks, int nworkers) {
+  using task_alloc = alloc<task_data, pooled_tasks>;
+  using entry_alloc = alloc<entry_data, pooled_entries>;
+  constexpr std::size_t batch_size = 256;
+  task_queue queue;
+  std::vector<std::thread> workers;
+  auto beg = std::chrono::high_resolution_clock::now();
+  for (int w = 0; w != nworkers; ++w)
+    workers.emplace_back([&queue] {
+      std::vector<void *> batch;
+      while (queue.pop(batch))
+        for (void *task : batch) task_alloc::deallocate(task);
+    });
+  std::vector<void *> batch;
+  batch.reserve(batch_size);
+  for (std::int64_t i = 0; i != ntasks; ++i) {
+    auto *entry = new (entry_alloc::allocate()) entry_data{i, task_alloc::allocate(), nullptr};
+    batch.push_back(entry->value);
+    entry_alloc::deallocate(entry);
+    if (batch.size() == batch_size) {
+      queue.push(std::move(batch));
+      batch = {};
+      batch.reserve(batch_size);
+    }
+  }
+  queue.push(std::move(batch));
+  queue.close();
+  for (auto &worker : workers) worker.join();
+  auto end = std::chrono::high_resolution_clock::now();
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - beg).count();
+  return static_cast<double>(ns) / ntasks;
+}
+
+template <bool pooled_tasks, bool pooled_entries>
+void report(const std::string &name, std::int64_t ntasks, int nworkers, int nreps) {
+  for (int rep = 0; rep != nreps; ++rep) {
+    const std::size_t nheap_allocs = ttg_madness::detail::object_pool_heap_allocations();
+    const double ns = measure<pooled_tasks, pooled_entries>(ntasks, nworkers);
+    std::cout << "task-alloc: " << name << ": " << ns << " ns/task, " << 1e9 / ns << " tasks/s, "
+              << ttg_madness::detail::object_pool_heap_allocations() - nheap_allocs << " pool heap allocations"
+              << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const std::int64_t ntasks = argc > 1 ? std::atol(argv[1]) : 1 << 22;
+  const int nworkers = argc > 2 ? std::atoi(argv[2]) : 3;
+  const int nreps = argc > 3 ? std::atoi(argv[3]) : 3;
+
+  report<false, false>("tasks and entries on the heap", ntasks, nworkers, nreps);
+  report<true, false>("tasks pooled, entries on the heap", ntasks, nworkers, nreps);
+  report<true, true>("tasks and entries pooled", ntasks, nworkers, nreps);
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+// Measures the rate of creation and execution of tasks with empty bodies: on every rank a generator task sends N
+// keys to a rank-local op that does nothing, hence the rate is bound by the overhead of the send path (output
+// terminals, keymaps, task creation and the call to the wrapped callable).
+//
+// Usage: task-rate [number of tasks per rank] [number of repetitions]
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// executes the graph rooted at \p start and @return the rate of execution of \p nexecuted tasks
+template <typename StartOp>
+double execute(StartOp &start, std::int64_t ntasks, std::atomic<std::int64_t> &nexecuted) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+#if defined(TTG_USE_MADNESS)
+  const std::size_t nheap_allocs = ttg_madness::detail::object_pool_heap_allocations();
+#endif
+  auto beg = std::chrono::high_resolution_clock::now();
+  start->invoke(world.rank());
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+#if defined(TTG_USE_MADNESS)
+  if (world.rank() == 0)
+    std::cout << "task-rate: " << ttg_madness::detail::object_pool_heap_allocations() - nheap_allocs
+              << " tasks allocated on the heap" << std::endl;
+#endif
+
+  double nexecuted_total = nexecuted.load();
+  ttg_sum(world, nexecuted_total);
+  if (nexecuted_total != static_cast<double>(ntasks) * nranks)
+    throw std::runtime_error("task-rate: executed " + std::to_string(nexecuted_total) + " tasks, expected " +
+                             std::to_string(ntasks * nranks));
+  const double seconds = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+  return nexecuted_total / seconds;
+}
+
+/// @param ninputs the number of inputs of the empty-body op (1 or 2)
+template <int ninputs>
+double task_rate(std::int64_t ntasks) {
+  const int nranks = ttg_default_execution_context().size();
+  auto keymap = [ntasks, nranks](const std::int64_t &key) { return static_cast<int>((key / ntasks) % nranks); };
+  std::atomic<std::int64_t> nexecuted = 0;
+
+  Edge<std::int64_t, int> in0("in0"), in1("in1");
+  if constexpr (ninputs == 1) {
+    auto start = wrap<int>(
+        [ntasks](const int &r, std::tuple<Out<std::int64_t, int>> &out) {
+          for (std::int64_t i = 0; i != ntasks; ++i) send<0>(r * ntasks + i, 0, out);
+        },
+        edges(), edges(in0), "start", {}, {"in0"});
+    start->set_keymap([](const int &r) { return r; });
+    auto empty = wrap([&nexecuted](const std::int64_t &key, const int &v0,
+                                   std::tuple<> &out) { nexecuted.fetch_add(1, std::memory_order_relaxed); },
+                      edges(in0), edges(), "empty", {"in0"}, {});
+    empty->set_keymap(keymap);
+    return execute(start, ntasks, nexecuted);
+  } else {
+    auto start = wrap<int>(
+        [ntasks](const int &r, std::tuple<Out<std::int64_t, int>, Out<std::int64_t, int>> &out) {
+          for (std::int64_t i = 0; i != ntasks; ++i) {
+            send<0>(r * ntasks + i, 0, out);
+            send<1>(r * ntasks + i, 1, out);
+          }
+        },
+        edges(), edges(in0, in1), "start", {}, {"in0", "in1"});
+    start->set_keymap([](const int &r) { return r; });
+    auto empty = wrap([&nexecuted](const std::int64_t &key, const int &v0, const int &v1,
+                                   std::tuple<> &out) { nexecuted.fetch_add(1, std::memory_order_relaxed); },
+                      edges(in0, in1), edges(), "empty", {"in0", "in1"}, {});
+    empty->set_keymap(keymap);
+    return execute(start, ntasks, nexecuted);
+  }
+}
+
+template <int ninputs>
+void report(std::int64_t ntasks, int nreps) {
+  for (int rep = 0; rep != nreps; ++rep) {
+    const double rate = task_rate<ninputs>(ntasks);
+    if (ttg_default_execution_context().rank() == 0)
+      std::cout << "task-rate: " << ninputs << " input(s): " << rate << " tasks/s" << std::endl;
+  }
+}
+
+int main(int argc, char **argv) {
+  const std::int64_t ntasks = argc > 1 ? std::atol(argv[1]) : 1000000;
+  const int nreps = argc > 2 ? std::atoi(argv[2]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  report<1>(ntasks, nreps);
+  report<2>(ntasks, nreps);
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
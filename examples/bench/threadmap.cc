@@ -0,0 +1,84 @@
+// Measures the effect of thread maps on cache reuse: on every rank a number of tiles is each updated by a chain of
+// tasks, every task sweeps its tile and passes it on to the next task of the chain. Without a thread map the tasks of
+// a chain run on whichever worker thread the scheduler picks, hence the tile migrates between the caches of the
+// cores; with a thread map all tasks of a chain are queued on the same worker thread. Thread maps are only honored by
+// backends with per-thread task queues (ttg::runtime_traits::supports_threadmap).
+//
+// Usage: threadmap [number of tiles per rank] [number of updates per tile] [number of repetitions]
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+using Tile = std::array<double, 16384>;  // 128 KiB, i.e. fits into the L2 cache of a core
+
+/// @return the time to update \p ntiles tiles per rank \p nupdates times each, in seconds
+double update_tiles(int ntiles, int nupdates, bool use_threadmap) {
+  auto world = ttg_default_execution_context();
+  const int rank = world.rank();
+
+  // the key of the u-th update of tile t is t * nupdates + u
+  Edge<int, Tile> tiles("tiles");
+
+  auto start = wrap<int>(
+      [ntiles, nupdates](const int &r, std::tuple<Out<int, Tile>> &out) {
+        for (int t = r * ntiles; t != (r + 1) * ntiles; ++t) {
+          Tile tile;
+          tile.fill(0.0);
+          send<0>(t * nupdates, std::move(tile), out);
+        }
+      },
+      edges(), edges(tiles), "start", {}, {"tiles"});
+  start->set_keymap([](const int &r) { return r; });
+
+  auto update = wrap(
+      [nupdates](const int &key, Tile &&tile, std::tuple<Out<int, Tile>> &out) {
+        for (int sweep = 0; sweep != 4; ++sweep)
+          for (auto &x : tile) x = 0.5 * x + 1.0;
+        if ((key + 1) % nupdates != 0) send<0>(key + 1, std::move(tile), out);
+      },
+      edges(tiles), edges(tiles), "update", {"tiles"}, {"tiles"});
+  update->set_keymap([ntiles, nupdates](const int &key) { return key / nupdates / ntiles; });
+  if (use_threadmap) update->set_threadmap([nupdates](const int &key) { return key / nupdates; });
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  ttg_fence(world);
+  auto beg = std::chrono::high_resolution_clock::now();
+  start->invoke(rank);
+  ttg_fence(world);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+}
+
+int main(int argc, char **argv) {
+  const int ntiles = argc > 1 ? std::atoi(argv[1]) : 64;
+  const int nupdates = argc > 2 ? std::atoi(argv[2]) : 100;
+  const int nreps = argc > 3 ? std::atoi(argv[3]) : 3;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  if (!runtime_traits<ttg_runtime>::supports_threadmap && ttg_default_execution_context().rank() == 0)
+    std::cout << "threadmap: this backend ignores thread maps" << std::endl;
+  for (const bool use_threadmap : {false, true}) {
+    for (int rep = 0; rep != nreps; ++rep) {
+      const double seconds = update_tiles(ntiles, nupdates, use_threadmap);
+      if (ttg_default_execution_context().rank() == 0)
+        std::cout << "threadmap: " << (use_threadmap ? "with" : "without") << " thread map: " << seconds << " s"
+                  << std::endl;
+    }
+  }
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
@@ -31,37 +31,16 @@ using namespace ttg;
 
 using namespace mra;
 
-/// Random process map
+/// Process map that keeps refinement trees local: boxes are partitioned along the Hilbert curve, hence parents
+/// live with their children
 template <Dimension NDIM>
 struct KeyProcMap {
-    const size_t size;
-    KeyProcMap() : size(get_default_world().size()) {}
-    std::size_t operator()(const Key<NDIM>& key) const {return key.hash() % size;}
+    const ttg::tree_keymap<NDIM> map;
+    KeyProcMap() : map(get_default_world().size()) {}
+    int operator()(const Key<NDIM>& key) const {return map(key.level(), key.translation());}
 };
 
 
-// /// A pmap that locates children on odd levels with their even level parents .. needs a litte fixing
-// template <typename keyT>
-// class LevelPmap : public WorldDCPmapInterface<keyT> {
-// private:
-//     const int nproc;
-// public:
-//     LevelPmap() : nproc(0) {};
-
-//     LevelPmap(World& world) : nproc(world.nproc()) {}
-
-//     /// Find the owner of a given key
-//     ProcessID owner(const keyT& key) const {
-//         Level n = key.level();
-//         if (n == 0) return 0;
-//         hashT hash;
-//         if (n <= 3 || (n&0x1)) hash = key.hash();
-//         else hash = key.parent().hash();
-//         return hash%nproc;
-//     }
-// };
-
-
 /// An empty class used for pure control flows
 struct Control {};
 std::ostream& operator<<(std::ostream& s, const Control& ctl) {s << "Ctl"; return s;}
@@ -127,7 +106,9 @@ auto make_project(functorT& f,
         send<1>(key, node, out); // always produce a result
     };
     ctlEdge<NDIM> refine("refine");
-    return wrap(F, edges(fuse(refine, ctl)), edges(refine, result), name, {"control"}, {"refine", "result"});
+    auto p = wrap(F, edges(fuse(refine, ctl)), edges(refine, result), name, {"control"}, {"refine", "result"});
+    p->set_keymap(KeyProcMap<NDIM>{});
+    return p;
 }
 
 namespace detail {
@@ -256,6 +237,8 @@ auto make_compress(rnodeEdge<T,K,NDIM>& in, cnodeEdge<T,K,NDIM>& out, const std:
 
     auto s = std::unique_ptr<sendwrapT>(new sendwrapT(&send_leaves_up<T,K,NDIM>, "send_leaves_up", {"input"}, outnames));
     auto c = std::unique_ptr<compwrapT>(new compwrapT(&do_compress<T,K,NDIM>, "do_compress", innames, outnames));
+    s->set_keymap(KeyProcMap<NDIM>{});
+    c->set_keymap(KeyProcMap<NDIM>{});
 
     in.set_out(s-> template in<0>()); // Connect input to s
     out.set_in(s-> template out<num_children>()); // Connect s result to output
@@ -313,6 +296,7 @@ auto make_reconstruct(const cnodeEdge<T,K,NDIM>& in, rnodeEdge<T,K,NDIM>& out, c
     Edge<Key<NDIM>,FixedTensor<T,K,NDIM>> S("S");  // passes scaling functions down
 
     auto s = wrapt(&do_reconstruct<T,K,NDIM>, edges(in, S), edges(S, out), name, {"input", "s"}, {"s", "output"});
+    s->set_keymap(KeyProcMap<NDIM>{});
 
     if (get_default_world().rank() == 0) {
         s->template in<1>()->send(Key<NDIM>{0,{0}}, FixedTensor<T,K,NDIM>()); // Prime the flow of scaling functions
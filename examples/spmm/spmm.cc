@@ -2,6 +2,7 @@
 #include <array>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <thread>
 #include <unordered_set>
@@ -179,13 +180,6 @@ std::ostream &operator<<(std::ostream &os, const Key<Rank> &key) {
   return os;
 }
 
-inline int tile2rank(int i, int j, int P, int Q) {
-  int p = (i % P);
-  int q = (j % Q);
-  int r = (q * P) + p;
-  return r;
-}
-
 // flow data from an existing SpMatrix on rank 0
 template <typename Blk = blk_t, typename Keymap = std::function<int(const Key<2> &)>>
 class Read_SpMatrix : public Op<Key<2>, std::tuple<Out<Key<2>, Blk>>, Read_SpMatrix<Blk>, void> {
@@ -288,6 +282,9 @@ class SpMM {
     TTGUNUSED(multiplyadd_);
   }
 
+  /// drops the task priorities memoized during an execution, see ttg::critical_path::clear()
+  void clear_priorities() { multiplyadd_->clear_priorities(); }
+
   /// Locally broadcast A[i][k] to all {i,j,k} such that B[j][k] exists
   class LocalBcastA : public Op<Key<3>, std::tuple<Out<Key<3>, Blk>>, LocalBcastA, Blk> {
    public:
@@ -298,7 +295,10 @@ class SpMM {
         : baseT(edges(a), edges(a_ijk), "SpMM::local_bcast_a", {"a_ik"}, {"a_ijk"},
                 [](const Key<3> &key) { return key[2]; })
         , b_rowidx_to_colidx_(b_rowidx_to_colidx)
-        , keymap_(keymap) {}
+        , keymap_(keymap) {
+      // only forwards the block, no need to go through the scheduler
+      this->set_execution_policy(ttg::Execution::Inline);
+    }
 
     void op(const Key<3> &key, typename baseT::input_values_tuple_type &&a_ik, std::tuple<Out<Key<3>, Blk>> &a_ijk) {
       const auto i = key[0];
@@ -368,7 +368,10 @@ class SpMM {
         : baseT(edges(b), edges(b_ijk), "SpMM::local_bcast_b", {"b_kj"}, {"b_ijk"},
                 [](const Key<3> &key) { return key[2]; })
         , a_colidx_to_rowidx_(a_colidx_to_rowidx)
-        , keymap_(keymap) {}
+        , keymap_(keymap) {
+      // only forwards the block, no need to go through the scheduler
+      this->set_execution_policy(ttg::Execution::Inline);
+    }
 
     void op(const Key<3> &key, typename baseT::input_values_tuple_type &&b_kj, std::tuple<Out<Key<3>, Blk>> &b_ijk) {
       const auto k = key[0];
@@ -444,8 +447,21 @@ class SpMM {
                   return keymap(key2);
                 })
         , a_rowidx_to_colidx_(a_rowidx_to_colidx)
-        , b_colidx_to_rowidx_(b_colidx_to_rowidx) {
-      this->set_priomap([=](const Key<3> &key) { return this->prio(key); });
+        , b_colidx_to_rowidx_(b_colidx_to_rowidx)
+        // the successor of {i,j,k} is {i,j,next_k}, hence the bottom level of a task with unit costs is the number
+        // of updates of its tile that remain, including its own
+        , critical_path_(
+              [](const Key<3> &) { return 1.0; },
+              [this](const Key<3> &key) {
+                auto [next_k, have_next_k] = compute_next_k(key[0], key[1], key[2]);
+                return have_next_k ? std::vector<Key<3>>{Key<3>({key[0], key[1], next_k})} : std::vector<Key<3>>{};
+              }) {
+      // the priority is the number of updates of the tile that follow this one, 0 for the last update
+      this->set_priomap([priomap = critical_path_.priomap()](const Key<3> &key) { return priomap(key) - 1; });
+      // all updates of a tile of C are queued on the same worker thread, which keeps the tile in that core's cache
+      this->set_threadmap([](const Key<3> &key) {
+        return static_cast<int>(Key<2>({key[0], key[1]}).hash() % std::numeric_limits<int>::max());
+      });
 
       // for each i and j that belongs to this node
       // determine first k that contributes, initialize input {i,j,first_k} flow to 0
@@ -508,24 +524,12 @@ class SpMM {
             result);
     }
 
+    void clear_priorities() { critical_path_.clear(); }
+
    private:
     const std::vector<std::vector<long>> &a_rowidx_to_colidx_;
     const std::vector<std::vector<long>> &b_colidx_to_rowidx_;
-
-    /* Compute the length of the remaining sequence on that tile */
-    int32_t prio(const Key<3> &key) {
-      const auto i = key[0];
-      const auto j = key[1];
-      const auto k = key[2];
-      int32_t len = -1;  // will be incremented at least once
-      long next_k = k;
-      bool have_next_k;
-      do {
-        std::tie(next_k, have_next_k) = compute_next_k(i, j, next_k);
-        ++len;
-      } while (have_next_k);
-      return len;
-    }
+    ttg::critical_path<Key<3>> critical_path_;
 
     // given {i,j} return first k such that A[i][k] and B[k][j] exist
     std::tuple<long, bool> compute_first_k(long i, long j) {
@@ -1193,6 +1197,7 @@ static void timed_measurement(SpMatrix<> &A, SpMatrix<> &B, const std::function<
   if (ttg_default_execution_context().rank() == 0) control.start(P, Q);
   ttg_fence(ttg_default_execution_context());
   gettimeofday(&end, nullptr);
+  a_times_b.clear_priorities();
   timersub(&end, &start, &diff);
   double tc = (double)diff.tv_sec + (double)diff.tv_usec / 1e6;
 #if defined(TTG_USE_MADNESS)
@@ -1335,12 +1340,8 @@ int main(int argc, char **argv) {
       }
     }
 
-    const auto &keymap = [P, Q](const Key<2> &key) {
-      int i = (int)key[0];
-      int j = (int)key[1];
-      int r = tile2rank(i, j, P, Q);
-      return r;
-    };
+    const auto &keymap = ttg::project_keymap(ttg::block_cyclic_2d(P, Q, 1, 1, ttg::grid_order::column_major),
+                                             [](const Key<2> &key) { return std::make_tuple(key[0], key[1]); });
 
     std::string seedStr(getCmdOption(argv, argv + argc, "-s"));
     unsigned int seed = parseOption(seedStr, 0);
@@ -1461,6 +1462,7 @@ int main(int argc, char **argv) {
 
       ttg_execute(ttg_default_execution_context());
       ttg_fence(ttg_default_execution_context());
+      a_times_b.clear_priorities();
 
       // validate C=A*B against the reference output
       assert(has_value(c_status));
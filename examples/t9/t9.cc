@@ -1,4 +1,6 @@
+#include <array>
 #include <cmath>
+#include <future>
 #include <iostream>
 
 #include "ttg.h"
@@ -298,11 +300,8 @@ class Norm2 : public Op<Key, std::tuple<>, Norm2, Node> {
     sumsq += (node.s * node.s + node.d * node.d) * boxsize;
   }
 
-  double get() const {
-    double value = sumsq;
-    ttg_sum(ttg_default_execution_context(), value);
-    return std::sqrt(value);
-  }
+  /// starts the reduction of the sum of squares over all ranks
+  std::future<double> get_sumsq() const { return ttg_allreduce(ttg_default_execution_context(), sumsq); }
 };
 
 auto make_norm2(const nodeEdge& in) { return std::make_unique<Norm2>(in); }  // for dull uniformity
@@ -363,6 +362,16 @@ int main(int argc, char** argv) {
 
     auto start = make_start(ctl);
 
+    // keep the trees local: boxes are partitioned along the Hilbert curve, hence parents live with their children
+    // and (mostly) with their neighbors
+    const auto keymap = ttg::project_keymap(ttg::tree_keymap<1>(ttg_default_execution_context().size()),
+                                            [](const Key& key) { return std::make_tuple(key.n, key.l); });
+    auto set_keymap = [&keymap](auto&... ops) { (ops->set_keymap(keymap), ...); };
+    set_keymap(p1, p2, p3, p4, p5, b1, b2, b3, b4, norma, normabcerr, normdifferr, norma2, norma3, start);
+    std::apply(set_keymap, d);
+    std::apply(set_keymap, comp1);
+    std::apply(set_keymap, recon1);
+
     // auto printer = make_printer(a);
     // auto printer2 = make_printer(b);
     // auto printer = make_printer(a_plus_b);
@@ -392,8 +401,11 @@ int main(int argc, char** argv) {
     ttg_execute(ttg_default_execution_context());
     ttg_fence(ttg_default_execution_context());
 
-    double nap = norma->get(), nac = norma2->get(), nar = norma3->get(), nabcerr = normabcerr->get(),
-           ndifferr = normdifferr->get();
+    // start all reductions before waiting for any
+    std::array<std::future<double>, 5> sumsqs = {norma->get_sumsq(), norma2->get_sumsq(), norma3->get_sumsq(),
+                                                 normabcerr->get_sumsq(), normdifferr->get_sumsq()};
+    double nap = std::sqrt(sumsqs[0].get()), nac = std::sqrt(sumsqs[1].get()), nar = std::sqrt(sumsqs[2].get()),
+           nabcerr = std::sqrt(sumsqs[3].get()), ndifferr = std::sqrt(sumsqs[4].get());
 
     if (ttg_default_execution_context().rank() == 0) {
       std::cout << "Norm2 of a projected     " << nap << std::endl;
@@ -0,0 +1,84 @@
+// Checks broadcasts to more keys than fit in a single active message: every rank broadcasts a small value to
+// nkeys keys on each rank. A broadcast of a value too large to be sent eagerly to a few keys per rank follows.
+// Every key must receive the value exactly once.
+//
+// Usage: broadcast [number of keys per rank]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ttg.h"
+#include "ttg/serialization/std/vector.h"
+
+using namespace ttg;
+
+/// every rank broadcasts a value of \p value_size elements to \p nkeys keys on each rank
+void run(std::int64_t nkeys, std::size_t value_size) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+  const int rank = world.rank();
+
+  std::atomic<std::int64_t> nreceived = 0;
+  std::atomic<std::int64_t> nwrong = 0;
+
+  // key k of the broadcast from rank r is r * nranks * nkeys + k and executes on rank k % nranks
+  Edge<std::int64_t, std::vector<std::int64_t>> bcast("bcast");
+  auto source = wrap<int>(
+      [nranks, nkeys, value_size](const int &r, std::tuple<Out<std::int64_t, std::vector<std::int64_t>>> &out) {
+        std::vector<std::int64_t> keys(nranks * nkeys);
+        for (std::int64_t k = 0; k != nranks * nkeys; ++k) keys[k] = r * nranks * nkeys + k;
+        broadcast<0>(keys, std::vector<std::int64_t>(value_size, r), out);
+      },
+      edges(), edges(bcast), "source", {}, {"bcast"});
+  source->set_keymap([](const int &r) { return r; });
+  auto sink = wrap(
+      [&nreceived, &nwrong, nranks, nkeys](const std::int64_t &key, const std::vector<std::int64_t> &value,
+                                           std::tuple<> &out) {
+        nreceived.fetch_add(1, std::memory_order_relaxed);
+        if (value.empty() || value.front() != key / (nranks * nkeys) || value.back() != value.front())
+          nwrong.fetch_add(1, std::memory_order_relaxed);
+      },
+      edges(bcast), edges(), "sink", {"bcast"}, {});
+  sink->set_keymap([nranks](const std::int64_t &key) { return static_cast<int>(key % nranks); });
+
+  auto connected = make_graph_executable(source.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  source->invoke(rank);
+  ttg_fence(world);
+
+  double nreceived_total = nreceived;
+  double nwrong_total = nwrong;
+  ttg_sum(world, nreceived_total);
+  ttg_sum(world, nwrong_total);
+  const double nexpected = static_cast<double>(nranks) * nranks * nkeys;
+  if (nreceived_total != nexpected || nwrong_total != 0)
+    throw std::runtime_error("broadcast: " + std::to_string(nreceived_total) + " keys received (" +
+                             std::to_string(nwrong_total) + " with a wrong value), expected " +
+                             std::to_string(nexpected));
+  if (rank == 0)
+    std::cout << "broadcast: " << nexpected << " keys received a value of " << value_size << " elements"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+  // the keys sent to one rank take 8 bytes each, so the default overflows a 1 MiB active message
+  const std::int64_t nkeys = argc > 1 ? std::atoll(argv[1]) : 200000;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  run(nkeys, 1);
+  // a value too large to be sent eagerly, received by few keys to bound the memory use
+  run(16, 1 << 18);
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
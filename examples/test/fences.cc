@@ -0,0 +1,74 @@
+// Checks back-to-back fences with work in between: every step sends a chain of messages around the ring of ranks,
+// then fences; the fence must return only after the whole chain has executed on all ranks. Steps alternate with
+// fences on empty graphs.
+//
+// Usage: fences [number of steps] [length of the chain]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "ttg.h"
+
+using namespace ttg;
+
+/// runs \p nsteps steps, each a chain of \p length hops started by every rank followed by two fences
+void run(int nsteps, int length) {
+  auto world = ttg_default_execution_context();
+  const int nranks = world.size();
+  const int rank = world.rank();
+
+  std::atomic<std::int64_t> nexecuted = 0;
+
+  // hop i of the chain started by rank r has key r * length + i and executes on rank (r + i) % nranks
+  Edge<std::int64_t, int> ring("ring");
+  auto start = wrap<int>(
+      [length](const int &r, std::tuple<Out<std::int64_t, int>> &out) {
+        send<0>(static_cast<std::int64_t>(r) * length, r, out);
+      },
+      edges(), edges(ring), "start", {}, {"ring"});
+  start->set_keymap([](const int &r) { return r; });
+  auto hop = wrap(
+      [&nexecuted, length](const std::int64_t &key, const int &r, std::tuple<Out<std::int64_t, int>> &out) {
+        nexecuted.fetch_add(1, std::memory_order_relaxed);
+        if (key % length + 1 < length) send<0>(key + 1, r, out);
+      },
+      edges(ring), edges(ring), "hop", {"ring"}, {"ring"});
+  hop->set_keymap([nranks, length](const std::int64_t &key) { return (key / length + key % length) % nranks; });
+
+  auto connected = make_graph_executable(start.get());
+  assert(connected);
+  TTGUNUSED(connected);
+
+  for (int step = 0; step != nsteps; ++step) {
+    start->invoke(rank);
+    ttg_fence(world);
+    // all hops of this step have executed once the fence returns
+    double nexecuted_total = nexecuted.exchange(0);
+    ttg_sum(world, nexecuted_total);
+    if (nexecuted_total != static_cast<double>(nranks) * length)
+      throw std::runtime_error("fences: step " + std::to_string(step) + " executed " +
+                               std::to_string(nexecuted_total) + " tasks before the fence returned, expected " +
+                               std::to_string(nranks * length));
+    // a fence with no work in between
+    ttg_fence(world);
+  }
+  if (rank == 0) std::cout << "fences: " << 2 * nsteps << " fences completed" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  const int nsteps = argc > 1 ? std::atoi(argv[1]) : 20;
+  const int length = argc > 2 ? std::atoi(argv[2]) : 100;
+
+  ttg_initialize(argc, argv, -1);
+  ttg_execute(ttg_default_execution_context());
+
+  run(nsteps, length);
+
+  ttg_fence(ttg_default_execution_context());
+  ttg_finalize();
+  return 0;
+}
@@ -202,7 +202,9 @@ namespace ttg {
           : baseT(edges(in), edges(out), std::string("read_spmatrix_shape(") + label + ")", {"ctl"},
                   {std::string("shape[") + label + "]"},
                   /* keymap */ []() { return owner; })
-          , matrix_(matrix) {}
+          , matrix_(matrix) {
+        this->set_execution_policy(ttg::Execution::Inline);
+      }
 
       void op(std::tuple<Out<void, Shape>> &out) { ::sendv<0>(Shape(matrix_), out); }
 
@@ -341,7 +343,9 @@ namespace ttg {
       Push(const char *label, Edge<void, Shape> &in, Edge<Key<2>, void> &out)
           : baseT(edges(in), edges(out), std::string("push_spmatrix(") + label + ")",
                   {std::string("shape[") + label + "]"}, {"ctl[ij]"},
-                  /* keymap */ []() { return owner; }) {}
+                  /* keymap */ []() { return owner; }) {
+        this->set_execution_policy(ttg::Execution::Inline);
+      }
 
       void op(typename baseT::input_values_tuple_type &&ins, std::tuple<Out<Key<2>, void>> &out) {
         const auto &shape = baseT::get<0>(ins);
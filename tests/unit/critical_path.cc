@@ -0,0 +1,94 @@
+#include "ttg/util/critical_path.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+  /// a chain of \p n tasks, i -> i+1, of cost i+1 each
+  ttg::critical_path<int> make_chain(int n, std::atomic<int> *ncosts = nullptr) {
+    return ttg::critical_path<int>(
+        [ncosts](const int &i) {
+          if (ncosts) ++*ncosts;
+          return static_cast<double>(i + 1);
+        },
+        [n](const int &i) { return i + 1 < n ? std::vector<int>{i + 1} : std::vector<int>{}; });
+  }
+}  // namespace
+
+TEST_CASE("CriticalPath", "[critical_path]") {
+  SECTION("chain") {
+    const int n = 100000;  // deep enough to overflow the stack of a recursive traversal
+    auto cp = make_chain(n);
+    CHECK(cp.bottom_level(n - 1) == n);
+    CHECK(cp.bottom_level(n - 2) == 2 * n - 1);
+    CHECK(cp.bottom_level(0) == static_cast<double>(n) * (n + 1) / 2);
+  }
+
+  SECTION("diamond") {
+    // 0 -> {1, 2} -> 3, the path through 2 is the most expensive
+    ttg::critical_path<int> cp([](const int &i) { return i == 2 ? 5.0 : 1.0; },
+                               [](const int &i) {
+                                 if (i == 0) return std::vector<int>{1, 2};
+                                 if (i == 1 || i == 2) return std::vector<int>{3};
+                                 return std::vector<int>{};
+                               });
+    CHECK(cp.bottom_level(3) == 1.0);
+    CHECK(cp.bottom_level(1) == 2.0);
+    CHECK(cp.bottom_level(0) == 7.0);
+    CHECK(cp.priority(0) > cp.priority(1));
+  }
+
+  SECTION("priority") {
+    ttg::critical_path<int> cp([](const int &i) { return i == 0 ? 1e300 : 0.25; },
+                               [](const int &) { return std::vector<int>{}; }, 10.0);
+    CHECK(cp.priority(1) == 3);  // round(2.5)
+    CHECK(cp.priority(0) == std::numeric_limits<int>::max());
+    auto priomap = cp.priomap<std::pair<int, int>>([](const std::pair<int, int> &key) { return key.first; });
+    CHECK(priomap(std::make_pair(1, 7)) == 3);
+  }
+
+  SECTION("cycle") {
+    // 0 -> 1 -> 2 -> 1
+    ttg::critical_path<int> cp([](const int &) { return 1.0; },
+                               [](const int &i) { return std::vector<int>{i == 2 ? 1 : i + 1}; });
+    CHECK_THROWS_AS(cp.bottom_level(0), std::logic_error);
+    // a self-loop
+    ttg::critical_path<int> self([](const int &) { return 1.0; }, [](const int &i) { return std::vector<int>{i}; });
+    CHECK_THROWS_AS(self.bottom_level(0), std::logic_error);
+  }
+
+  SECTION("memoization") {
+    std::atomic<int> ncosts = 0;
+    auto cp = make_chain(10, &ncosts);
+    CHECK(cp.bottom_level(0) == 55);
+    CHECK(ncosts == 10);
+    CHECK(cp.bottom_level(5) == 40);
+    CHECK(ncosts == 10);
+    cp.clear();
+    CHECK(cp.bottom_level(5) == 40);
+    CHECK(ncosts == 15);
+  }
+
+  SECTION("concurrent") {
+    const int n = 1000;
+    auto cp = make_chain(n);
+    auto priomap = cp.priomap();
+    std::atomic<bool> ok = true;
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 4; ++t)
+      threads.emplace_back([&, t] {
+        for (int i = t; i < n; i += 3)
+          if (priomap(i) != (static_cast<std::int64_t>(n) * (n + 1) - static_cast<std::int64_t>(i) * (i + 1)) / 2)
+            ok = false;
+      });
+    for (auto &thread : threads) thread.join();
+    CHECK(ok);
+  }
+}
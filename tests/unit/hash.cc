@@ -0,0 +1,94 @@
+#include "ttg/util/hash.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <set>
+#include <tuple>
+#include <utility>
+
+namespace {
+  struct Padded {
+    int i;
+    long l;
+  };
+
+  struct Unpadded {
+    int i, j;
+  };
+
+  struct WithMember {
+    int i;
+    std::size_t hash() const { return 42; }
+  };
+
+  /// fills the storage of t with byte \p b , then sets it to \p value
+  template <typename T>
+  void assign_over_garbage(T& t, const T& value, unsigned char b) {
+    std::memset(static_cast<void*>(&t), b, sizeof(T));
+    t = value;
+  }
+}  // namespace
+
+TEST_CASE("Hash", "[hash]") {
+  SECTION("traits") {
+    static_assert(ttg::detail::is_bytewise_hashable_v<int>);
+    static_assert(ttg::detail::is_bytewise_hashable_v<Unpadded>);
+    static_assert(!ttg::detail::is_bytewise_hashable_v<Padded>);
+    static_assert(ttg::meta::has_ttg_hash_specialization_v<std::pair<std::pair<int, int>, int>>);
+    static_assert(ttg::meta::has_ttg_hash_specialization_v<std::tuple<int, char, long>>);
+    static_assert(ttg::meta::has_ttg_hash_specialization_v<std::array<Padded, 2>>);
+  }
+
+  SECTION("member hash() takes precedence") { CHECK(ttg::hash<WithMember>{}(WithMember{1}) == 42); }
+
+  SECTION("padding does not affect the hash of std::pair/std::tuple/std::array") {
+    using pair_t = std::pair<std::pair<int, int>, long>;
+    pair_t p1, p2;
+    assign_over_garbage(p1, pair_t{{1, 2}, 3}, 0x00);
+    assign_over_garbage(p2, pair_t{{1, 2}, 3}, 0xff);
+    CHECK(ttg::hash<pair_t>{}(p1) == ttg::hash<pair_t>{}(p2));
+
+    using tuple_t = std::tuple<char, long, int>;
+    tuple_t t1, t2;
+    assign_over_garbage(t1, tuple_t{'a', 2, 3}, 0x00);
+    assign_over_garbage(t2, tuple_t{'a', 2, 3}, 0xff);
+    CHECK(ttg::hash<tuple_t>{}(t1) == ttg::hash<tuple_t>{}(t2));
+
+    using array_t = std::array<std::pair<char, long>, 2>;
+    array_t a1, a2;
+    assign_over_garbage(a1, array_t{{{'a', 1}, {'b', 2}}}, 0x00);
+    assign_over_garbage(a2, array_t{{{'a', 1}, {'b', 2}}}, 0xff);
+    CHECK(ttg::hash<array_t>{}(a1) == ttg::hash<array_t>{}(a2));
+  }
+
+  SECTION("distinct keys rarely collide") {
+    std::set<std::size_t> h_int, h_pair, h_array, h_unpadded;
+    const int n = 64;
+    for (int i = 0; i != n; ++i) {
+      for (int j = 0; j != n; ++j) {
+        h_int.insert(ttg::hash<int>{}(i * n + j));
+        h_pair.insert(ttg::hash<std::pair<int, int>>{}({i, j}));
+        h_array.insert(ttg::hash<std::array<long, 2>>{}({i, j}));
+        h_unpadded.insert(ttg::hash<Unpadded>{}({i, j}));
+      }
+    }
+    CHECK(h_int.size() == n * n);
+    CHECK(h_pair.size() == n * n);
+    CHECK(h_array.size() == n * n);
+    CHECK(h_unpadded.size() == n * n);
+  }
+
+  SECTION("low bits are well distributed") {
+    // the default keymap uses hash % nranks
+    const int nbins = 8;
+    const int n = 8 * 1024;
+    std::array<int, nbins> counts{};
+    for (int i = 0; i != n; ++i) counts[ttg::hash<std::pair<int, int>>{}({i, 0}) % nbins]++;
+    for (auto c : counts) {
+      CHECK(c > n / nbins / 2);
+      CHECK(c < 2 * n / nbins);
+    }
+  }
+}
@@ -0,0 +1,216 @@
+#include "ttg/base/keymap.h"
+#include "ttg/util/keymaps.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+  using tile_keymap = std::function<int(int, int)>;
+
+  /// counts the messages of a tiled Cholesky factorization of an \p nt x \p nt matrix whose tasks are owned by the
+  /// owners of the tiles they update; a task sends a single message to each remote process that runs one or more of
+  /// its consumers, as ttg::broadcast does
+  long cholesky_messages(int nt, const tile_keymap &owner) {
+    long nmsgs = 0;
+    auto send = [&](int from, const std::vector<std::pair<int, int>> &consumers) {
+      std::set<int> ranks;
+      for (auto &&[i, j] : consumers) ranks.insert(owner(i, j));
+      ranks.erase(owner(from / nt, from % nt));
+      nmsgs += ranks.size();
+    };
+    for (int k = 0; k != nt; ++k) {
+      // POTRF(k) -> TRSM(m,k)
+      std::vector<std::pair<int, int>> trsms;
+      for (int m = k + 1; m < nt; ++m) trsms.emplace_back(m, k);
+      send(k * nt + k, trsms);
+      // TRSM(m,k) -> SYRK(m,k), GEMM(m,n,k) n in (k,m), GEMM(p,m,k) p > m
+      for (int m = k + 1; m < nt; ++m) {
+        std::vector<std::pair<int, int>> updates{{m, m}};
+        for (int n = k + 1; n < m; ++n) updates.emplace_back(m, n);
+        for (int p = m + 1; p < nt; ++p) updates.emplace_back(p, m);
+        send(m * nt + k, updates);
+      }
+    }
+    return nmsgs;
+  }
+
+  /// counts the parent-child messages of the refinement of a full binary tree of depth \p depth
+  long refinement_messages(int depth, const std::function<int(int, std::uint64_t)> &owner) {
+    long nmsgs = 0;
+    for (int n = 0; n != depth; ++n)
+      for (std::uint64_t l = 0; l != (std::uint64_t(1) << n); ++l)
+        for (std::uint64_t c = 2 * l; c != 2 * l + 2; ++c)
+          if (owner(n, l) != owner(n + 1, c)) ++nmsgs;
+    return nmsgs;
+  }
+}  // namespace
+
+TEST_CASE("Keymaps", "[keymaps]") {
+  SECTION("block_cyclic_1d") {
+    ttg::block_cyclic_1d cyclic(4);
+    CHECK(cyclic(0) == 0);
+    CHECK(cyclic(5) == 1);
+    ttg::block_cyclic_1d blocked(3, 2, 1);
+    const std::array<int, 8> expected{1, 1, 2, 2, 0, 0, 1, 1};
+    for (int i = 0; i != 8; ++i) CHECK(blocked(i) == expected[i]);
+  }
+
+  SECTION("block_cyclic_2d") {
+    const int P = 2, Q = 3;
+    ttg::block_cyclic_2d row_major(P, Q);
+    ttg::block_cyclic_2d col_major(P, Q, 1, 1, ttg::grid_order::column_major);
+    std::set<int> ranks;
+    for (int i = 0; i != 2 * P; ++i)
+      for (int j = 0; j != 2 * Q; ++j) {
+        CHECK(row_major(i, j) == (i % P) * Q + (j % Q));
+        CHECK(col_major(i, j) == (j % Q) * P + (i % P));
+        ranks.insert(row_major(i, j));
+      }
+    CHECK(ranks.size() == P * Q);
+    ttg::block_cyclic_2d blocked(P, Q, 2, 3);
+    CHECK(blocked(1, 2) == 0);
+    CHECK(blocked(2, 3) == Q + 1);
+  }
+
+  SECTION("block_cyclic_3d") {
+    ttg::block_cyclic_3d bc(2, 2, 2);
+    std::set<int> ranks;
+    for (int i = 0; i != 2; ++i)
+      for (int j = 0; j != 2; ++j)
+        for (int k = 0; k != 2; ++k) ranks.insert(bc(i, j, k));
+    CHECK(ranks.size() == static_cast<std::size_t>(bc.nranks()));
+    CHECK(bc(1, 0, 1) == 5);
+    CHECK(bc(3, 2, 5) == bc(1, 0, 1));
+  }
+
+  SECTION("diagonal_block_cyclic_2d") {
+    const int P = 3, Q = 3;
+    ttg::block_cyclic_2d bc(P, Q);
+    ttg::diagonal_block_cyclic_2d dbc(P, Q, 1, 1, true);
+    std::set<int> bc_diag_ranks, dbc_diag_ranks;
+    for (int k = 0; k != P * Q; ++k) {
+      bc_diag_ranks.insert(bc(k, k));
+      dbc_diag_ranks.insert(dbc(k, k));
+    }
+    CHECK(bc_diag_ranks.size() == P);
+    CHECK(dbc_diag_ranks.size() == P * Q);
+    CHECK(dbc(4, 1) == bc(4, 1));
+    CHECK(dbc(1, 4) == dbc(4, 1));
+  }
+
+  SECTION("range_block") {
+    ttg::range_block rb(10, 4);
+    const std::array<int, 10> expected{0, 0, 0, 1, 1, 1, 2, 2, 3, 3};
+    for (int i = 0; i != 10; ++i) CHECK(rb(i) == expected[i]);
+    for (int r = 0; r != 4; ++r)
+      for (auto i = rb.begin(r); i != rb.end(r); ++i) CHECK(rb(i) == r);
+    CHECK(rb.end(3) == 10);
+  }
+
+  SECTION("project_keymap") {
+    using key3 = std::tuple<int, int, int>;
+    ttg::block_cyclic_2d bc(2, 2);
+    auto ij = ttg::project_keymap(bc, [](const key3 &key) { return std::make_pair(std::get<0>(key), std::get<1>(key)); });
+    CHECK(ij(key3{1, 0, 7}) == bc(1, 0));
+    auto k = ttg::project_keymap(ttg::range_block(8, 2), [](const key3 &key) { return std::get<2>(key); });
+    CHECK(k(key3{1, 0, 7}) == 1);
+    std::function<int(const key3 &)> keymap = ij;  // installable via Op::set_keymap
+    CHECK(keymap(key3{1, 1, 0}) == bc(1, 1));
+  }
+
+  SECTION("remote messages") {
+    const int P = 4, Q = 4, nt = 32;
+    ttg::detail::default_keymap_impl<std::pair<int, int>> hash(P * Q);
+    ttg::block_cyclic_2d bc(P, Q);
+    ttg::diagonal_block_cyclic_2d dbc(P, Q);
+    const long hash_msgs = cholesky_messages(nt, [&](int i, int j) { return hash(std::make_pair(i, j)); });
+    const long bc_msgs = cholesky_messages(nt, std::cref(bc));
+    const long dbc_msgs = cholesky_messages(nt, std::cref(dbc));
+    // broadcasts of a panel tile reach a single row or column of the grid rather than (almost) all ranks
+    CHECK(3 * bc_msgs < 2 * hash_msgs);
+    CHECK(3 * dbc_msgs < 2 * hash_msgs);
+  }
+
+  SECTION("space-filling curves") {
+    const int nbits = 3;
+    const std::uint64_t n = 1 << nbits;
+    std::set<std::uint64_t> morton, hilbert;
+    std::vector<std::array<std::uint64_t, 2>> boxes(n * n);
+    for (std::uint64_t x = 0; x != n; ++x)
+      for (std::uint64_t y = 0; y != n; ++y) {
+        morton.insert(ttg::detail::morton_index<2>({x, y}, nbits));
+        const auto h = ttg::detail::hilbert_index<2>({x, y}, nbits);
+        hilbert.insert(h);
+        boxes.at(h) = {x, y};
+      }
+    CHECK(morton.size() == n * n);
+    CHECK(hilbert.size() == n * n);
+    CHECK(ttg::detail::morton_index<2>({1, 0}, nbits) == 2);
+    // consecutive boxes along the Hilbert curve are face neighbors
+    for (std::size_t h = 1; h != boxes.size(); ++h) {
+      const auto dist = std::abs(long(boxes[h][0]) - long(boxes[h - 1][0])) +
+                        std::abs(long(boxes[h][1]) - long(boxes[h - 1][1]));
+      CHECK(dist == 1);
+    }
+    // the curve is nested: the children of a box are contiguous
+    for (std::uint64_t x = 0; x != n; ++x)
+      for (std::uint64_t y = 0; y != n; ++y)
+        CHECK(ttg::detail::hilbert_index<2>({x, y}, nbits) >> 2 ==
+              ttg::detail::hilbert_index<2>({x >> 1, y >> 1}, nbits - 1));
+  }
+
+  SECTION("tree_keymap") {
+    const int nranks = 8;
+    ttg::tree_keymap<3> octree(nranks, 2);
+    std::set<int> ranks;
+    for (std::uint64_t x = 0; x != 4; ++x)
+      for (std::uint64_t y = 0; y != 4; ++y)
+        for (std::uint64_t z = 0; z != 4; ++z) {
+          const int owner = octree(2, std::array<std::uint64_t, 3>{x, y, z});
+          ranks.insert(owner);
+          // the subtree below level 2 stays with its root
+          CHECK(octree(5, std::array<std::uint64_t, 3>{8 * x + 7, 8 * y, 8 * z + 3}) == owner);
+        }
+    CHECK(ranks.size() == nranks);
+    ttg::tree_keymap<1> bintree(nranks, 6, ttg::space_filling_curve::morton);
+    CHECK(bintree(0, 0) == 0);
+    CHECK(bintree(6, 63) == nranks - 1);
+    CHECK(bintree(10, 1023) == nranks - 1);
+  }
+
+  SECTION("tree remote messages") {
+    const int nranks = 16, depth = 16;
+    ttg::detail::default_keymap_impl<std::pair<int, std::uint64_t>> hash(nranks);
+    ttg::tree_keymap<1> tree(nranks);
+    const long hash_msgs = refinement_messages(depth, [&](int n, std::uint64_t l) { return hash(std::make_pair(n, l)); });
+    const long tree_msgs = refinement_messages(depth, std::cref(tree));
+    CHECK(tree_msgs < nranks * depth);
+    CHECK(100 * tree_msgs < hash_msgs);
+  }
+
+  SECTION("map_with_default") {
+    const int nranks = 4;
+    ttg::detail::default_keymap_impl<int> hash(nranks);
+    ttg::detail::keymap_type_t<int> keymap(hash);
+    CHECK(keymap(5) == hash(5));
+    keymap = [](const int &key) { return key % 3; };
+    CHECK(keymap(5) == 2);
+    std::function<int(const int &)> fn = keymap;
+    CHECK(fn(7) == 1);
+    keymap = hash;
+    CHECK(keymap(7) == hash(7));
+
+    ttg::detail::priomap_type_t<void> priomap(ttg::detail::default_priomap_impl<void>{});
+    CHECK(priomap() == 0);
+    priomap = []() { return 7; };
+    CHECK(priomap() == 7);
+  }
+}
@@ -19,7 +19,9 @@
 #include "ttg/op.h"
 #include "ttg/reduce.h"
 #include "ttg/traverse.h"
+#include "ttg/util/critical_path.h"
 #include "ttg/util/dot.h"
+#include "ttg/util/keymaps.h"
 #include "ttg/util/macro.h"
 #include "ttg/util/print.h"
 #include "ttg/world.h"
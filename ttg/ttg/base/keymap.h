@@ -44,6 +44,76 @@ namespace ttg {
       operator()() const { return 0; }
     };
 
+    /// A keymap (or priomap) that calls the default map \c DefaultMap directly and any other map through
+    /// \c meta::detail::keymap_t<keyT>: the default maps are used by most ops, and would otherwise cost an indirect
+    /// call per task. Callable like the \c std::function it replaces.
+    template <typename keyT, typename DefaultMap>
+    class map_with_default {
+     public:
+      using function_type = meta::detail::keymap_t<keyT>;
+
+      /// \param map if derived from \c DefaultMap it is used as the default map, else it is type-erased
+      template <typename Map, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Map>, map_with_default>>>
+      map_with_default(Map &&map) {
+        *this = std::forward<Map>(map);
+      }
+
+      map_with_default(const map_with_default &) = default;
+      map_with_default(map_with_default &&) = default;
+      map_with_default &operator=(const map_with_default &) = default;
+      map_with_default &operator=(map_with_default &&) = default;
+
+      template <typename Map, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Map>, map_with_default>>>
+      map_with_default &operator=(Map &&map) {
+        if constexpr (std::is_base_of_v<DefaultMap, std::decay_t<Map>>) {
+          default_map = std::forward<Map>(map);
+          is_default = true;
+          this->map = nullptr;
+        } else {
+          this->map = std::forward<Map>(map);
+          is_default = false;
+        }
+        return *this;
+      }
+
+      template <typename Key = keyT>
+      std::enable_if_t<!meta::is_void_v<Key>, int> operator()(const Key &key) const {
+        return is_default ? default_map(key) : map(key);
+      }
+      template <typename Key = keyT>
+      std::enable_if_t<meta::is_void_v<Key>, int> operator()() const {
+        return is_default ? default_map() : map();
+      }
+
+      /// @return the map as a \c std::function
+      operator function_type() const {
+        if (is_default) return default_map;
+        return map;
+      }
+
+     private:
+      DefaultMap default_map = {};
+      function_type map;
+      bool is_default = true;
+    };
+
+    /// the type of the keymaps of ops with keys of type \c keyT ; a map_with_default if \c keyT has a default keymap
+    template <typename keyT, typename Enabler = void>
+    struct keymap_type {
+      using type = meta::detail::keymap_t<keyT>;
+    };
+    template <typename keyT>
+    struct keymap_type<keyT,
+                       std::enable_if_t<meta::has_ttg_hash_specialization_v<keyT> || meta::is_void_v<keyT>>> {
+      using type = map_with_default<keyT, default_keymap_impl<keyT>>;
+    };
+    template <typename keyT>
+    using keymap_type_t = typename keymap_type<keyT>::type;
+
+    /// the type of the priomaps of ops with keys of type \c keyT
+    template <typename keyT>
+    using priomap_type_t = map_with_default<keyT, default_priomap_impl<keyT>>;
+
   }  // namespace detail
 
 } // namespace ttg
@@ -1,17 +1,25 @@
 #ifndef TTG_BASE_OP_H
 #define TTG_BASE_OP_H
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <sstream>
 #include <vector>
 
 #include "ttg/base/terminal.h"
+#include "ttg/execution.h"
 #include "ttg/util/demangle.h"
+#include "ttg/util/trace.h"
 
 namespace ttg {
 
+  class World;
+
   namespace detail {
     // If true prints trace of all assignments and all op invocations
     inline bool &op_base_trace_accessor(void) {
@@ -36,6 +44,15 @@ namespace ttg {
 
     bool executable;
 
+    std::optional<Execution> execution_policy;  //< If not set the backend decides how to execute tasks
+    std::size_t max_inline_depth;               //< Max # of tasks nested on a thread's stack by inline execution
+
+    // work of this op on this rank, see activity()
+    std::atomic<std::uint64_t> ntasks_created = 0;
+    std::atomic<std::uint64_t> ntasks_completed = 0;
+    std::atomic<std::uint64_t> nmsgs_sent = 0;
+    std::atomic<std::uint64_t> nmsgs_received = 0;
+
     // Default copy/move/assign all OK
     static uint64_t next_instance_id() {
       static uint64_t id = 0;
@@ -99,6 +116,12 @@ namespace ttg {
       set_terminals(std::make_index_sequence<std::tuple_size<terminalsT>::value>{}, terms, setfunc);
     }
 
+    // Used by the backends to account for the work of this op, see activity()
+    void count_task_created() { ntasks_created.fetch_add(1, std::memory_order_relaxed); }
+    void count_task_completed() { ntasks_completed.fetch_add(1, std::memory_order_release); }
+    void count_msg_sent() { nmsgs_sent.fetch_add(1, std::memory_order_relaxed); }
+    void count_msg_received() { nmsgs_received.fetch_add(1, std::memory_order_release); }
+
   private:
     OpBase(const OpBase &) = delete;
     OpBase &operator=(const OpBase &) = delete;
@@ -115,7 +138,8 @@ namespace ttg {
         , is_composite(false)
         , is_within_composite(false)
         , containing_composite_op(0)
-        , executable(false) {
+        , executable(false)
+        , max_inline_depth(std::numeric_limits<std::size_t>::max()) {
       // std::cout << name << "@" << (void *)this << " -> " << instance_id << std::endl;
     }
 
@@ -137,7 +161,31 @@ namespace ttg {
 
     /// Returns true if tracing set for either this instance or all instances
     bool get_trace() { return ttg::detail::op_base_trace_accessor() || trace_instance; }
-    bool tracing() { return get_trace(); }
+    /// Returns true if tracing is compiled in (see ttg::trace_enabled) and set for either this instance or all instances
+    bool tracing() {
+      if constexpr (ttg::trace_enabled)
+        return get_trace();
+      else
+        return false;
+    }
+
+    /// Sets the execution policy of the tasks of this operation
+
+    /// With Execution::Inline a task that becomes ready is executed right away on the thread that made it ready,
+    /// bypassing the scheduler, as long as fewer than \p max_depth tasks are executing on the stack of that thread;
+    /// otherwise, and with Execution::Async, the task is submitted to the scheduler. Inline execution suits cheap
+    /// operations, e.g. ones that merely forward or broadcast their inputs.
+    /// If not set the backend chooses the policy.
+    void set_execution_policy(Execution policy, std::size_t max_depth = std::numeric_limits<std::size_t>::max()) {
+      execution_policy = policy;
+      max_inline_depth = max_depth;
+    }
+
+    /// @return the execution policy set by set_execution_policy(), or an empty optional if it was not set
+    const std::optional<Execution> &get_execution_policy() const { return execution_policy; }
+
+    /// @return the max number of tasks on the stack of a thread for tasks of this operation to be executed inline
+    std::size_t get_max_inline_depth() const { return max_inline_depth; }
 
     void set_is_composite(bool value) { is_composite = value; }
     bool get_is_composite() const { return is_composite; }
@@ -194,6 +242,20 @@ namespace ttg {
     /// Waits for the entire TTG associated with this op to be completed (collective)
     virtual void fence() = 0;
 
+    /// @return the world this op executes in; the default world, unless overridden (see ttg/world.h)
+    virtual ttg::World get_world() const;
+
+    /// @return the number of tasks of this op created and completed on this rank, and the number of messages to
+    ///         instances of this op sent and received by this rank (a message may be sent and received on different
+    ///         ranks); used to detect the termination of subsets of ops, see ttg::base::WorldImplBase::fence
+    virtual std::array<std::uint64_t, 4> activity() const {
+      // N.B. read the completion counts first so that completed work is never seen without its creation
+      const std::uint64_t completed = ntasks_completed.load(std::memory_order_acquire);
+      const std::uint64_t received = nmsgs_received.load(std::memory_order_acquire);
+      return {ntasks_created.load(std::memory_order_relaxed), completed, nmsgs_sent.load(std::memory_order_relaxed),
+              received};
+    }
+
     /// Marks this executable
     /// @return nothing
     virtual void make_executable() = 0;
@@ -1,12 +1,20 @@
 #ifndef TTG_BASE_WORLD_H
 #define TTG_BASE_WORLD_H
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <future>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 #include "ttg/base/op.h"
 
@@ -36,6 +44,7 @@ namespace ttg {
       std::vector<std::shared_ptr<std::promise<void>>> m_statuses;
       std::vector<std::function<void()>> m_callbacks;
       std::vector<std::shared_ptr<void>> m_ptrs;
+      std::mutex m_mtx;  // guards m_statuses and m_callbacks, which may be registered while fence_async is running
       bool m_is_valid = true;
 
      protected:
@@ -43,6 +52,9 @@ namespace ttg {
 
       virtual void fence_impl(void) = 0;
 
+      /// replaces each of the \p n elements of \p values by its sum over all ranks (collective)
+      virtual void allreduce_sum(std::uint64_t *values, std::size_t n) = 0;
+
       void release_ops(void) {
         while (!m_op_register.empty()) {
           (*m_op_register.begin())->release();
@@ -66,24 +78,75 @@ namespace ttg {
       }
 
       void register_status(const std::shared_ptr<std::promise<void>>& status_ptr) {
+        std::scoped_lock lock(m_mtx);
         m_statuses.emplace_back(status_ptr);
       }
 
       template <typename Callback>
       void register_callback(Callback&& callback) {
+        std::scoped_lock lock(m_mtx);
         m_callbacks.emplace_back(callback);
       }
 
       void fence(void) {
         fence_impl();
-        for (auto& status : m_statuses) {
+        std::vector<std::shared_ptr<std::promise<void>>> statuses;
+        std::vector<std::function<void()>> callbacks;
+        {
+          std::scoped_lock lock(m_mtx);
+          statuses.swap(m_statuses);
+          callbacks.swap(m_callbacks);
+        }
+        for (auto& status : statuses) {
           status->set_value();
         }
-        m_statuses.clear();  // clear out the statuses
-        for (auto&& callback : m_callbacks) {
+        for (auto&& callback : callbacks) {
           callback();
         }
-        m_callbacks.clear();  // clear out the statuses
+      }
+
+      /// starts fence() on a separate thread (collective); backends whose collectives are bound to the main thread
+      /// defer the fence to the thread that waits for the future instead (see ttg_madness::WorldImpl)
+      /// @return the future completion of the fence
+      /// \note until the future is ready this thread may build new ops, but must not send to or invoke ops of this
+      ///       world
+      virtual std::future<void> fence_async(void) {
+        return std::async(std::launch::async, [this] { fence(); });
+      }
+
+      /// waits until the ops in \p ops have no pending tasks and no messages in flight on any rank (collective);
+      /// unlike fence(), other ops of this world may keep executing
+      /// \note the ops are deemed terminated once they are idle, hence ops not in \p ops must not send to them
+      ///       afterwards
+      void fence(const std::vector<ttg::OpBase*>& ops) {
+        // four-counter termination detection: the ops have terminated if, summed over all ranks, every created task
+        // has completed and every sent message has been received, and the sums did not change since the previous
+        // round
+        std::array<std::uint64_t, 4> previous = {};
+        bool first = true;
+        // back off between rounds so that waiting ranks do not flood the network with allreduces, up to the
+        // maximum delay
+        constexpr std::chrono::microseconds max_backoff{1000};
+        std::chrono::microseconds backoff{1};
+        while (true) {
+          std::array<std::uint64_t, 4> totals = {};
+          for (auto op : ops) {
+            const auto activity = op->activity();
+            for (std::size_t i = 0; i != totals.size(); ++i) totals[i] += activity[i];
+          }
+          allreduce_sum(totals.data(), totals.size());
+          if (!first && totals == previous && totals[0] == totals[1] && totals[2] == totals[3]) break;
+          first = false;
+          previous = totals;
+          std::this_thread::sleep_for(backoff);
+          backoff = std::min(2 * backoff, max_backoff);
+        }
+      }
+
+      /// starts fence(ops) on a separate thread (collective), see fence_async()
+      /// @return the future completion of the fence
+      virtual std::future<void> fence_async(std::vector<ttg::OpBase*> ops) {
+        return std::async(std::launch::async, [this, ops = std::move(ops)] { fence(ops); });
       }
 
       virtual void execute() {}
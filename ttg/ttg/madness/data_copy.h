@@ -0,0 +1,177 @@
+#ifndef TTG_MADNESS_DATA_COPY_H
+#define TTG_MADNESS_DATA_COPY_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ttg_madness {
+
+  namespace detail {
+
+    /// whether the local consumers of a value of type \c T share a single copy of it rather than copying it each;
+    /// small trivially-copyable values are cheaper to copy than to share
+    template <typename T>
+    inline constexpr bool is_shared_v = !(std::is_trivially_copyable_v<T> && sizeof(T) <= 64);
+
+    /// identifies type \c T by the address of \c type_tag<T>
+    template <typename T>
+    inline constexpr char type_tag = 0;
+
+    /// a value that the calling thread passes to consumers, see copy_scope
+    struct tracked_copy {
+      const void *addr;              // the address of the value, as seen by the consumers
+      const void *type;              // the type of the value, see type_tag
+      std::shared_ptr<void> copy;    // the copy shared by the consumers; empty until the first local consumer makes it
+      std::weak_ptr<void> claimed;   // the shared copy, once the last consumer has claimed it
+    };
+
+    /// the values tracked by the copy_scope's of the calling thread, innermost last
+    inline thread_local std::vector<tracked_copy> tracked_copies;
+
+    /// @return the tracked copy of \p value , or nullptr if \p value is not tracked
+    template <typename T>
+    tracked_copy *find_tracked(const T &value) {
+      if constexpr (is_shared_v<T>) {
+        auto &copies = tracked_copies;
+        for (auto it = copies.rbegin(); it != copies.rend(); ++it)
+          if (it->addr == &value && it->type == &type_tag<T>) return &*it;
+      }
+      return nullptr;
+    }
+
+    /// @return whether \p value is tracked, i.e. its local consumers share a copy of it
+    template <typename T>
+    bool is_tracked(const T &value) {
+      return find_tracked(value) != nullptr;
+    }
+
+    /// @return the copy of \p value shared by its local consumers, made by the first of them; empty if \p value is not
+    ///         tracked
+    /// \param claim whether the caller is the last consumer of \p value ; the tracker then drops its reference, so that
+    ///        the caller may mutate the copy in place if it is the only consumer left
+    template <typename T>
+    std::shared_ptr<T> share(const T &value, bool claim = false) {
+      auto *tracked = find_tracked(value);
+      if (tracked == nullptr) return {};
+      std::shared_ptr<void> copy = tracked->copy ? tracked->copy : tracked->claimed.lock();
+      if (!copy) copy = std::make_shared<T>(value);
+      if (claim) {
+        tracked->claimed = copy;
+        tracked->copy.reset();
+      } else
+        tracked->copy = copy;
+      return std::static_pointer_cast<T>(std::move(copy));
+    }
+
+    /// Tracks the values passed to consumers within its lifetime, so that the consumers on this rank share a single
+    /// reference-counted copy of a value (see data_copy) rather than copying it each. Scopes nest, the values tracked
+    /// by a scope are untracked when it is destroyed.
+    class copy_scope {
+      std::size_t ntracked = 0;
+
+     public:
+      copy_scope() = default;
+      copy_scope(const copy_scope &) = delete;
+      copy_scope &operator=(const copy_scope &) = delete;
+
+      ~copy_scope() {
+        auto &copies = tracked_copies;
+        copies.erase(copies.end() - ntracked, copies.end());
+      }
+
+      /// tracks \p value , which must outlive this scope; the shared copy is made by the first local consumer, hence
+      /// values consumed only by other ranks are not copied
+      template <typename T>
+      void track(const T &value) {
+        if constexpr (is_shared_v<T>) {
+          tracked_copies.push_back(tracked_copy{&value, &type_tag<T>, {}, {}});
+          ++ntracked;
+        }
+      }
+
+      /// tracks the value held by \p copy , which is shared with its consumers as is
+      template <typename T>
+      void track(std::shared_ptr<T> copy) {
+        if constexpr (is_shared_v<T>) {
+          const void *addr = copy.get();
+          tracked_copies.push_back(tracked_copy{addr, &type_tag<T>, std::move(copy), {}});
+          ++ntracked;
+        }
+      }
+    };
+
+    /// The value of an input of a task; shares the copy of a tracked value (see copy_scope) with the other consumers
+    /// on this rank, and copies it only when it is mutated while still shared (copy on write)
+    template <typename T>
+    class data_copy {
+      T value_;                    // the value, unless shared
+      std::shared_ptr<T> shared_;  // the shared copy of the value, if any
+
+     public:
+      /// sets the value to \p value , sharing its copy if \p value is tracked; an rvalue \p value is the last consumer
+      /// of a tracked value (see ttg::Out::send)
+      template <typename Value>
+      void set(Value &&value) {
+        if (auto copy = share(static_cast<const T &>(value), !std::is_lvalue_reference_v<Value>)) {
+          shared_ = std::move(copy);
+          return;
+        }
+        assign(std::forward<Value>(value));
+      }
+
+      /// sets the value to \p value , without sharing
+      template <typename Value>
+      void assign(Value &&value) {
+        value_ = std::forward<Value>(value);
+        shared_.reset();
+      }
+
+      /// @return the value, for reading
+      const T &get() const { return shared_ ? *shared_ : value_; }
+
+      /// @return the value, for mutation; the value is copied if it is still shared with other consumers
+      T &get_mutable() {
+        if (shared_) {
+          if (shared_.use_count() == 1) {
+            // use_count() is a relaxed load: synchronize with the release of the other consumers' references, so that
+            // their reads of the value happen before it is mutated
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return *shared_;
+          }
+          value_ = *shared_;
+          shared_.reset();
+        }
+        return value_;
+      }
+
+      /// tracks the value in \p scope , so that the consumers it is sent to share it
+      void track(copy_scope &scope) const {
+        if (shared_)
+          scope.track(shared_);
+        else
+          scope.track(value_);
+      }
+    };
+
+    template <typename Tuple>
+    struct data_copies;
+
+    template <typename... Ts>
+    struct data_copies<std::tuple<Ts...>> {
+      using type = std::tuple<data_copy<Ts>...>;
+    };
+
+    /// maps \c std::tuple<Ts...> to \c std::tuple<data_copy<Ts>...>
+    template <typename Tuple>
+    using data_copies_t = typename data_copies<Tuple>::type;
+
+  }  // namespace detail
+
+}  // namespace ttg_madness
+
+#endif  // TTG_MADNESS_DATA_COPY_H
@@ -3,7 +3,9 @@
 
 #include "ttg/fwd.h"
 
+#include <functional>
 #include <future>
+#include <vector>
 
 namespace ttg_madness {
 
@@ -25,6 +27,12 @@ namespace ttg_madness {
 
   inline void ttg_fence(ttg::World world);
 
+  inline std::future<void> ttg_fence_async(ttg::World world);
+
+  inline void ttg_fence(ttg::World world, const std::vector<ttg::OpBase *> &ops);
+
+  inline std::future<void> ttg_fence_async(ttg::World world, std::vector<ttg::OpBase *> ops);
+
   template <typename T>
   inline void ttg_register_ptr(ttg::World world, const std::shared_ptr<T> &ptr);
 
@@ -32,9 +40,15 @@ namespace ttg_madness {
 
   inline ttg::Edge<> &ttg_ctl_edge(ttg::World world);
 
+  template <typename T, typename Op = std::plus<T>>
+  std::future<T> ttg_allreduce(ttg::World world, const T &value, Op op = Op{});
+
   template <typename T>
   inline void ttg_sum(ttg::World world, T &value);
 
+  template <typename T>
+  std::future<T> ttg_broadcast_async(ttg::World world, T data, int source_rank);
+
   template <typename T>
   inline void ttg_broadcast(ttg::World world, T &data, int source_rank);
 
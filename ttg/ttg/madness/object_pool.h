@@ -0,0 +1,127 @@
+#ifndef TTG_MADNESS_OBJECT_POOL_H
+#define TTG_MADNESS_OBJECT_POOL_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ttg_madness {
+
+  namespace detail {
+
+    /// @return the number of memory blocks that all object_pool's have obtained from the heap
+    inline std::atomic<std::size_t> &object_pool_heap_allocations() {
+      static std::atomic<std::size_t> n = 0;
+      return n;
+    }
+
+    /// Pool of memory blocks for objects of type T, used to avoid a heap allocation for every task.
+
+    /// Each thread keeps a free list of blocks; blocks travel between threads via a shared depot in batches, so that
+    /// blocks freed by the threads that execute tasks get back to the threads that create them.
+    /// Blocks are returned to the heap only when threads exit and at program exit.
+    template <typename T>
+    class object_pool {
+      union block {
+        block *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+      };
+
+      static constexpr std::size_t batch_size = 64;              // # of blocks moved to/from the depot at once
+      static constexpr std::size_t max_cached = 4 * batch_size;  // max # of blocks in a thread's free list
+
+      static void free_list(block *head) {
+        while (head != nullptr) {
+          block *next = head->next;
+          ::operator delete(head, std::align_val_t(alignof(block)));
+          head = next;
+        }
+      }
+
+      struct depot_t {
+        std::mutex mtx;
+        std::vector<block *> batches;  // free lists of batch_size blocks each
+
+        ~depot_t() {
+          for (auto batch : batches) free_list(batch);
+        }
+      };
+
+      struct cache_t {
+        block *head = nullptr;
+        std::size_t size = 0;
+
+        ~cache_t() {
+          while (size >= batch_size) give_batch(*this);
+          free_list(head);  // the remainder is not worth a batch
+        }
+      };
+
+      static depot_t &depot() {
+        static depot_t d;
+        return d;
+      }
+
+      static cache_t &cache() {
+        static thread_local cache_t c;
+        return c;
+      }
+
+      /// moves batch_size blocks from the front of \p c to the depot
+      static void give_batch(cache_t &c) {
+        block *batch = c.head;
+        block *last = batch;
+        for (std::size_t i = 1; i != batch_size; ++i) last = last->next;
+        c.head = last->next;
+        c.size -= batch_size;
+        last->next = nullptr;
+        auto &d = depot();
+        std::scoped_lock lock(d.mtx);
+        d.batches.push_back(batch);
+      }
+
+      /// moves a batch of blocks from the depot to \p c , if available
+      static void take_batch(cache_t &c) {
+        assert(c.head == nullptr);
+        auto &d = depot();
+        std::scoped_lock lock(d.mtx);
+        if (!d.batches.empty()) {
+          c.head = d.batches.back();
+          c.size = batch_size;
+          d.batches.pop_back();
+        }
+      }
+
+     public:
+      /// @return memory for an object of type T
+      static void *allocate() {
+        auto &c = cache();
+        if (c.head == nullptr) take_batch(c);
+        if (c.head != nullptr) {
+          block *b = c.head;
+          c.head = b->next;
+          --c.size;
+          return b;
+        }
+        object_pool_heap_allocations().fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(sizeof(block), std::align_val_t(alignof(block)));
+      }
+
+      /// returns memory obtained from allocate() to the pool
+      static void deallocate(void *ptr) {
+        auto &c = cache();
+        block *b = static_cast<block *>(ptr);
+        b->next = c.head;
+        c.head = b;
+        if (++c.size > max_cached) give_batch(c);
+      }
+    };
+
+  }  // namespace detail
+
+}  // namespace ttg_madness
+
+#endif  // TTG_MADNESS_OBJECT_POOL_H
@@ -0,0 +1,141 @@
+#ifndef TTG_MADNESS_PRIORITY_QUEUE_H
+#define TTG_MADNESS_PRIORITY_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <madness/world/MADworld.h>
+#include <madness/world/world_task_queue.h>
+
+namespace ttg_madness {
+
+  namespace detail {
+
+    /// Ready queue that orders tasks by their (integer) priority.
+
+    /// MADNESS' task queue only distinguishes high-priority tasks from the rest, hence prioritized tasks are kept
+    /// here and the MADNESS task queue receives, for every such task, a high-priority proxy task that executes the
+    /// highest-priority task ready at the time the proxy runs. Each thread pushes to its own queue of priority
+    /// buckets, proxies pop from the queue with the highest nonempty bucket, stealing from other threads' queues if
+    /// needed. Tasks within a bucket are executed in FIFO order.
+    ///
+    /// Only positive priorities are ordered: WorldImpl::submit sends tasks with priority <= 0 directly to the MADNESS
+    /// task queue, and a priority <= 0 submitted here shares bucket 0 with no ordering among such tasks.
+    class priority_queue {
+     public:
+      /// bucket 0 holds priorities <= 0 (all unordered), positive priorities are binned with 2 buckets per power of 2
+      static constexpr int nbuckets = 63;
+
+      /// @return the bucket of priority \p priority
+      static constexpr int bucket(int priority) {
+        if (priority <= 0) return 0;
+        int log2 = 0;
+        while ((priority >> log2) > 1) ++log2;
+        const int half = log2 > 0 ? (priority >> (log2 - 1)) & 1 : 0;
+        return 1 + 2 * log2 + half;
+      }
+
+      explicit priority_queue(std::size_t nqueues)
+          : nqueues_(nqueues > 0 ? nqueues : 1), queues_(std::make_unique<thread_queue[]>(nqueues_)) {}
+
+      priority_queue(const priority_queue &) = delete;
+      priority_queue &operator=(const priority_queue &) = delete;
+
+      /// submits \p task with priority \p priority to the task queue of \p world
+      /// \note takes ownership of \p task , it will be deleted after execution
+      void submit(::madness::World &world, ::madness::TaskInterface *task, int priority) {
+        push(task, priority);
+        world.taskq.add(new proxy_task(*this));
+      }
+
+     private:
+      struct alignas(64) thread_queue {
+        std::mutex mtx;
+        std::atomic<std::uint64_t> nonempty = 0;  // bit b is set if buckets[b] is nonempty
+        std::array<std::deque<::madness::TaskInterface *>, nbuckets> buckets;
+      };
+
+      /// executes the highest-priority task in the queue
+      class proxy_task : public ::madness::TaskInterface {
+        priority_queue &queue_;
+
+       public:
+        explicit proxy_task(priority_queue &queue)
+            : ::madness::TaskInterface(::madness::TaskAttributes(::madness::TaskAttributes::HIGHPRIORITY))
+            , queue_(queue) {}
+
+        void run(::madness::World &world) override {
+          ::madness::TaskInterface *task = queue_.pop();
+          task->run(world);
+          delete task;
+        }
+      };
+
+      std::size_t nqueues_;
+      std::unique_ptr<thread_queue[]> queues_;
+
+      /// @return the index of the highest set bit of \p mask , or -1 if \p mask is zero
+      static int top(std::uint64_t mask) { return mask == 0 ? -1 : 63 - __builtin_clzll(mask); }
+
+      /// @return the index of the queue of the calling thread
+      std::size_t this_queue() const {
+        static std::atomic<std::size_t> nthreads = 0;
+        static thread_local const std::size_t thread_idx = nthreads++;
+        return thread_idx % nqueues_;
+      }
+
+      void push(::madness::TaskInterface *task, int priority) {
+        const int b = bucket(priority);
+        auto &q = queues_[this_queue()];
+        std::scoped_lock lock(q.mtx);
+        q.buckets[b].push_back(task);
+        q.nonempty.store(q.nonempty.load(std::memory_order_relaxed) | (std::uint64_t(1) << b),
+                         std::memory_order_release);
+      }
+
+      /// N.B. every proxy pops exactly one task pushed before it was submitted, hence pop always succeeds eventually
+      ::madness::TaskInterface *pop() {
+        const std::size_t own = this_queue();
+        while (true) {
+          // find the queue with the highest nonempty bucket, preferring own queue on ties
+          std::size_t best = own;
+          int best_top = top(queues_[own].nonempty.load(std::memory_order_acquire));
+          for (std::size_t i = 1; i != nqueues_; ++i) {
+            const std::size_t victim = (own + i) % nqueues_;
+            const int victim_top = top(queues_[victim].nonempty.load(std::memory_order_acquire));
+            if (victim_top > best_top) {
+              best = victim;
+              best_top = victim_top;
+            }
+          }
+          if (best_top < 0) {
+            // the task of this proxy was taken by another proxy, let the thread that pushes the next one run
+            std::this_thread::yield();
+            continue;
+          }
+
+          auto &q = queues_[best];
+          std::scoped_lock lock(q.mtx);
+          const int b = top(q.nonempty.load(std::memory_order_relaxed));
+          if (b < 0) continue;  // lost the race for this queue
+          auto &bucket = q.buckets[b];
+          ::madness::TaskInterface *task = bucket.front();
+          bucket.pop_front();
+          if (bucket.empty())
+            q.nonempty.store(q.nonempty.load(std::memory_order_relaxed) & ~(std::uint64_t(1) << b),
+                             std::memory_order_release);
+          return task;
+        }
+      }
+    };
+
+  }  // namespace detail
+
+}  // namespace ttg_madness
+
+#endif  // TTG_MADNESS_PRIORITY_QUEUE_H
@@ -19,18 +19,26 @@
 #include "ttg/util/hash.h"
 #include "ttg/util/macro.h"
 #include "ttg/util/meta.h"
+#include "ttg/util/partial_reduction.h"
 #include "ttg/util/void.h"
 #include "ttg/world.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <madness/world/MADworld.h>
@@ -40,10 +48,18 @@
 
 #include <madness/world/world_task_queue.h>
 
+#include "ttg/madness/data_copy.h"
+#include "ttg/madness/object_pool.h"
+#include "ttg/madness/priority_queue.h"
+
 #include <boost/callable_traits.hpp>  // needed for wrap.h
 
 namespace ttg_madness {
 
+  namespace detail {
+    inline thread_local std::size_t task_depth = 0;  // # of tasks executing on the stack of this thread
+  }  // namespace detail
+
 #if 0
     class Control;
     class Graph;
@@ -68,6 +84,11 @@ namespace ttg_madness {
 
     ttg::Edge<> m_ctl_edge;
 
+    detail::priority_queue m_ready_queue{::madness::ThreadPool::size() + 1};
+
+    // MADNESS collectives (gop.fence(), gop.sum()) must be issued by the thread that created the world
+    const std::thread::id m_main_thread = std::this_thread::get_id();
+
    public:
     WorldImpl(::madness::World &world) : m_impl(world) {}
 
@@ -91,7 +112,27 @@ namespace ttg_madness {
 
     virtual int rank(void) const override { return m_impl.rank(); }
 
-    virtual void fence_impl(void) override { m_impl.gop.fence(); }
+    virtual void fence_impl(void) override {
+      assert(std::this_thread::get_id() == m_main_thread && "ttg_madness: fence must be called by the main thread");
+      m_impl.gop.fence();
+    }
+
+    virtual void allreduce_sum(std::uint64_t *values, std::size_t n) override {
+      assert(std::this_thread::get_id() == m_main_thread && "ttg_madness: fence must be called by the main thread");
+      m_impl.gop.sum(values, n);
+    }
+
+    /// MADNESS collectives must be issued by the main thread, hence the fence is deferred: it runs when the returned
+    /// future is waited for, on the waiting thread, which must be the main thread. Until then the tasks of this world
+    /// keep executing on the MADNESS thread pool.
+    virtual std::future<void> fence_async(void) override {
+      return std::async(std::launch::deferred, [this] { fence(); });
+    }
+
+    /// deferred like fence_async(), see there
+    virtual std::future<void> fence_async(std::vector<ttg::OpBase *> ops) override {
+      return std::async(std::launch::deferred, [this, ops = std::move(ops)] { fence(ops); });
+    }
 
     ttg::Edge<> &ctl_edge() { return m_ctl_edge; }
 
@@ -114,6 +155,17 @@ namespace ttg_madness {
 
     const ::madness::World &impl() const { return m_impl; }
 
+    /// submits a ready task to the task queue
+    /// \param task the task, will be deleted after execution
+    /// \param priority the priority of the task; tasks with positive priority are executed before the rest, in the
+    ///        order of decreasing priority
+    void submit(::madness::TaskInterface *task, int priority) {
+      if (priority > 0)
+        m_ready_queue.submit(m_impl, task, priority);
+      else
+        m_impl.taskq.add(task);
+    }
+
 #ifdef ENABLE_PARSEC
     parsec_context_t *context() { return ::madness::ThreadPool::instance()->parsec; }
 #endif
@@ -139,6 +191,14 @@ namespace ttg_madness {
   }
   inline void ttg_fence(ttg::World world) { world.impl().fence(); }
 
+  inline std::future<void> ttg_fence_async(ttg::World world) { return world.impl().fence_async(); }
+
+  inline void ttg_fence(ttg::World world, const std::vector<ttg::OpBase *> &ops) { world.impl().fence(ops); }
+
+  inline std::future<void> ttg_fence_async(ttg::World world, std::vector<ttg::OpBase *> ops) {
+    return world.impl().fence_async(std::move(ops));
+  }
+
   template <typename T>
   inline void ttg_register_ptr(ttg::World world, const std::shared_ptr<T> &ptr) {
     world.impl().register_ptr(ptr);
@@ -155,10 +215,40 @@ namespace ttg_madness {
 
   inline ttg::Edge<> &ttg_ctl_edge(ttg::World world) { return world.impl().ctl_edge(); }
 
+  /// all-reduce
+  /// reduces \p value over all ranks of \p world with \c Op
+  /// @tparam T a trivially-copyable type
+  /// @tparam Op an associative and commutative binary operation on \c T
+  /// @return the result, ready on return
+  /// \note MADNESS' global operations execute tasks while waiting for remote ranks, hence completing the reduction
+  ///       before returning does not stall the worker threads
+  template <typename T, typename Op>
+  std::future<T> ttg_allreduce(ttg::World world, const T &value, Op op) {
+    static_assert(std::is_trivially_copyable_v<T>, "ttg_allreduce: T must be trivially copyable");
+    T result = value;
+    world.impl().impl().gop.reduce(&result, 1, op);
+    std::promise<T> promise;
+    promise.set_value(std::move(result));
+    return promise.get_future();
+  }
+
   template <typename T>
   inline void ttg_sum(ttg::World world, T &value) {
     world.impl().impl().gop.sum(value);
   }
+
+  /// broadcast
+  /// broadcasts \p data from \p source_rank to all ranks of \p world
+  /// @tparam T a serializable type
+  /// @return the broadcast value, ready on return (see ttg_allreduce)
+  template <typename T>
+  std::future<T> ttg_broadcast_async(ttg::World world, T data, int source_rank) {
+    world.impl().impl().gop.broadcast_serializable(data, source_rank);
+    std::promise<T> promise;
+    promise.set_value(std::move(data));
+    return promise.get_future();
+  }
+
   /// broadcast
   /// @tparam T a serializable type
   template <typename T>
@@ -182,16 +272,19 @@ namespace ttg_madness {
 
    private:
     ttg::World world;
-    ttg::meta::detail::keymap_t<keyT> keymap;
-    ttg::meta::detail::keymap_t<keyT> priomap;
+    ttg::detail::keymap_type_t<keyT> keymap;
+    ttg::detail::priomap_type_t<keyT> priomap;
+    ttg::meta::detail::keymap_t<keyT> threadmap;  //!< Maps keys to worker threads (empty = no preference)
     // For now use same type for unary/streaming input terminals, and stream reducers assigned at runtime
     ttg::meta::detail::input_reducers_t<input_valueTs...>
         input_reducers;  //!< Reducers for the input terminals (empty = expect single value)
+    std::array<bool, sizeof...(input_valueTs)>
+        commutative_reducers = {};  //!< Whether streaming inputs are reduced into per-thread partial results
 
     std::array<std::size_t, sizeof...(input_valueTs)> static_streamsize;
 
    public:
-    ttg::World get_world() const { return world; }
+    ttg::World get_world() const override { return world; }
 
    protected:
     using opT = Op<keyT, output_terminalsT, derivedT, input_valueTs...>;
@@ -244,7 +337,8 @@ namespace ttg_madness {
       using TaskInterface = ::madness::TaskInterface;
 
      public:
-      int counter;  // Tracks the number of arguments finalized
+      int priority;  // Priority of the task, as given by priomap
+      int counter;   // Tracks the number of arguments finalized
       std::array<std::size_t, numins>
           nargs;  // Tracks the number of expected values
                   // for any type of input: 0 = finalized;
@@ -255,25 +349,47 @@ namespace ttg_madness {
                   // - n: if nonstreaming: expect this many more values
       std::array<std::size_t, numins> stream_size;  // Expected number of values to receive, to be used for streaming
                                                     // inputs (0 = unbounded stream, >0 = bounded stream)
-      input_values_tuple_type input_values;         // The input values (does not include control)
+      detail::data_copies_t<input_values_tuple_type> input_values;  // The input values (does not include control)
+      std::tuple<std::unique_ptr<ttg::detail::partial_reduction<ttg::meta::void_to_Void_t<std::decay_t<input_valueTs>>>>...>
+          partials;                                 // Partial results of streaming inputs with commutative reducers
       derivedT *derived;                            // Pointer to derived class instance
       std::conditional_t<ttg::meta::is_void_v<keyT>, ttg::Void, keyT> key;  // Task key
 
-      /// makes a tuple of references out of tuple of
-      template <typename Tuple, std::size_t... Is>
-      static input_refs_tuple_type make_input_refs_impl(Tuple &&inputs, std::index_sequence<Is...>) {
-        return input_refs_tuple_type{
-            get<Is, std::tuple_element_t<Is, input_refs_tuple_type>>(std::forward<Tuple>(inputs))...};
+      template <std::size_t i>
+      static constexpr bool is_const_input_v =
+          std::is_const_v<std::remove_reference_t<std::tuple_element_t<i, input_refs_tuple_type>>>;
+
+      /// @return a reference to input value \c i ; a mutable input that is shared with other tasks is copied first
+      template <std::size_t i>
+      std::tuple_element_t<i, input_refs_tuple_type> input_ref() {
+        if constexpr (is_const_input_v<i>)
+          return std::get<i>(this->input_values).get();
+        else
+          return std::get<i>(this->input_values).get_mutable();
+      }
+
+      template <std::size_t... Is>
+      input_refs_tuple_type make_input_refs_impl(std::index_sequence<Is...>) {
+        return input_refs_tuple_type{input_ref<Is>()...};
       }
 
       /// makes a tuple of references out of input_values
       input_refs_tuple_type make_input_refs() {
-        return make_input_refs_impl(this->input_values,
-                                    std::make_index_sequence<std::tuple_size_v<input_values_tuple_type>>{});
+        return make_input_refs_impl(std::make_index_sequence<std::tuple_size_v<input_values_tuple_type>>{});
+      }
+
+      /// tracks the read-only input values in \p scope , so that the tasks this task sends them to share them
+      template <std::size_t... Is>
+      void track_const_inputs(detail::copy_scope &scope, std::index_sequence<Is...>) {
+        auto track = [&](auto &input, auto is_const) {
+          if constexpr (decltype(is_const)::value) input.track(scope);
+        };
+        (track(std::get<Is>(this->input_values), std::bool_constant<is_const_input_v<Is>>{}), ...);
       }
 
       OpArgs(int prio = 0)
-          : TaskInterface(TaskAttributes(prio ? TaskAttributes::HIGHPRIORITY : 0))
+          : TaskInterface(TaskAttributes(prio > 0 ? TaskAttributes::HIGHPRIORITY : 0))
+          , priority(prio)
           , counter(numins)
           , nargs()
           , stream_size()
@@ -287,6 +403,9 @@ namespace ttg_madness {
         using ttg::hash;
         opT::threaddata.key_hash = hash<decltype(key)>{}(key);
         opT::threaddata.call_depth++;
+        detail::task_depth++;
+        detail::copy_scope inputs;
+        track_const_inputs(inputs, std::make_index_sequence<std::tuple_size_v<input_values_tuple_type>>{});
 
         if constexpr (!ttg::meta::is_void_v<keyT> && !ttg::meta::is_empty_tuple_v<input_values_tuple_type>) {
           derived->op(key, this->make_input_refs(),
@@ -301,13 +420,25 @@ namespace ttg_madness {
         } else
           abort();
 
+        detail::task_depth--;
         opT::threaddata.call_depth--;
+        derived->count_task_completed();
+        // N.B. only between tasks, a task executed inline may be nested in a thread that holds cache entries
+        if constexpr (!ttg::meta::is_void_v<keyT>)
+          if (derived->migration_enabled && detail::task_depth == 0) derived->balance_load();
 
         // ttg::print("finishing task",opT::threaddata.call_depth);
       }
 
       virtual ~OpArgs() {}  // Will be deleted via TaskInterface*
 
+      // tasks are allocated from a pool rather than the heap
+      static void *operator new(std::size_t size) {
+        assert(size == sizeof(OpArgs));
+        return detail::object_pool<OpArgs>::allocate();
+      }
+      static void operator delete(void *ptr) { detail::object_pool<OpArgs>::deallocate(ptr); }
+
      private:
       ::madness::Spinlock lock_;  // synchronizes access to data
      public:
@@ -320,6 +451,21 @@ namespace ttg_madness {
     using accessorT = typename cacheT::accessor;
     cacheT cache;
 
+    // migration of tasks between ranks, see set_key_migration
+    static constexpr std::size_t max_migration_candidates = 1 << 16;
+    bool migration_enabled = false;
+    std::size_t migration_overloaded = 0;  // a rank with more pending tasks is overloaded
+    std::size_t migration_idle = 0;        // a rank with fewer pending tasks is idle
+    std::size_t migration_batch = 0;       // max # of tasks migrated at once
+    std::mutex migration_mtx;              // guards migration_candidates, migrated, and donors
+    std::deque<hashable_keyT> migration_candidates;  // keys of tasks that wait for inputs, oldest first
+    std::unordered_map<hashable_keyT, std::pair<int, int>, ttg::hash<hashable_keyT>>
+        migrated;                                     // key -> {rank the task migrated to, # of inputs to forward}
+    std::vector<int> donors;                          // ranks that migrated tasks here since this rank was idle
+    std::unique_ptr<std::atomic<bool>[]> idle_ranks;  // whether a rank is known to accept migrated tasks
+    std::atomic<bool> migrating = false;              // whether a thread of this rank is migrating tasks
+    int next_thief = 0;                               // the first rank to consider for the next migration
+
    protected:
     // there are 6 types of set_arg:
     // - case 1: nonvoid Key, complete Value type
@@ -330,14 +476,95 @@ namespace ttg_madness {
     // - case 6:    void Key, void Value, no inputs
     // cases 2 and 5 will be implemented by passing dummy ttg::Void object to reduce the number of code branches
 
+    /// executes ready task \p args on the calling thread or submits it to the task queue, as directed by the
+    /// execution policy of this op (see ttg::OpBase::set_execution_policy)
+    /// \param inline_by_default whether to execute the task inline if the execution policy is not set
+    void submit_ready_task(OpArgs *args, bool inline_by_default = false) {
+      this->count_task_created();
+      const auto &policy = this->get_execution_policy();
+      const bool execute_inline =
+          policy ? *policy == ttg::Execution::Inline && detail::task_depth < this->get_max_inline_depth()
+                 : inline_by_default;
+      if (execute_inline) {
+        const auto key_hash = threaddata.key_hash;
+        args->run(world.impl().impl());
+        threaddata.key_hash = key_hash;
+        delete args;
+      } else
+        world.impl().submit(args, args->priority);
+    }
+
+    /// invokes member function \c memfn of this op on behalf of a remote rank, see send_remote()
+    template <auto memfn, typename... Args>
+    void remote_call(const Args &...args) {
+      (this->*memfn)(args...);
+      // N.B. after memfn, so that the tasks it creates are accounted for before the message is
+      this->count_msg_received();
+    }
+
+    /// invokes member function \c memfn of this op on rank \p owner with arguments \p args ;
+    /// the message is accounted for in the activity of this op (see ttg::OpBase::activity)
+    template <auto memfn, typename... Args>
+    void send_remote(int owner, const Args &...args) {
+      this->count_msg_sent();
+      worldobjT::send(owner, &opT::template remote_call<memfn, Args...>, args...);
+    }
+
+    /// reduces \p value into the calling thread's partial result of commutative streaming input \c i of task \p args
+    /// \param acc the accessor holding the cache entry of \p args ; released while reducing, so that
+    ///        threads contributing to the same stream do not serialize
+    /// \return true if the stream is complete and this was the last contribution in flight; then the partial results
+    ///         have been combined into the input value and \p acc again holds the cache entry of \p args
+    template <std::size_t i, typename Value>
+    bool reduce_partial(accessorT &acc, OpArgs *args, Value &&value) {
+      auto &partials = std::get<i>(args->partials);
+      if (!partials)
+        partials = std::make_unique<std::decay_t<decltype(*partials)>>(
+            ::madness::ThreadPool::size() + 2, args->stream_size[i] != 0 ? args->stream_size[i] : static_streamsize[i]);
+      auto *p = partials.get();
+      const auto key = acc->first;
+      p->enter();
+      acc.release();
+      // N.B. args may be completed by another contributor or finalize_argstream once this contribution is out, must
+      //      not touch it unless told to complete the stream
+      if (!p->reduce(std::get<i>(input_reducers), std::forward<Value>(value))) return false;
+
+      [[maybe_unused]] const bool found = cache.find(acc, key);
+      assert(found && acc->second == args);
+      return complete_partials<i>(args);
+    }
+
+    /// completes commutative streaming input \c i of task \p args , unless it is not closed, contributions are in
+    /// flight or it has been completed already (see ttg::detail::partial_reduction::try_complete)
+    /// \return true if the stream was completed, i.e. the partial results have been combined into the input value
+    /// \note the caller must hold the cache entry of \p args
+    template <std::size_t i>
+    bool complete_partials(OpArgs *args) {
+      if (!std::get<i>(args->partials)->try_complete()) return false;
+      combine_partials<i>(args);
+      args->nargs[i] = 0;
+      args->counter--;
+      return true;
+    }
+
+    /// combines the partial results of commutative streaming input \c i of task \p args into its input value
+    /// \note the caller must hold the cache entry of \p args
+    template <std::size_t i>
+    void combine_partials(OpArgs *args) {
+      if constexpr (!ttg::meta::is_void_v<std::tuple_element_t<i, input_values_full_tuple_type>>) {
+        auto &partials = std::get<i>(args->partials);
+        if (partials) {
+          auto value = partials->combine(std::get<i>(input_reducers));
+          if (value) std::get<i>(args->input_values).assign(std::move(*value));
+          partials.reset();
+        }
+      }
+    }
+
     // case 1:
     template <std::size_t i, typename Key, typename Value>
     std::enable_if_t<!ttg::meta::is_void_v<Key> && !std::is_void_v<std::decay_t<Value>>, void> set_arg(const Key &key,
                                                                                                        Value &&value) {
-      using valueT = typename std::tuple_element<i, input_values_full_tuple_type>::type;  // Should be T or const T
-      static_assert(std::is_same_v<std::decay_t<Value>, std::decay_t<valueT>>,
-                    "Op::set_arg(key,value) given value of type incompatible with Op");
-
       const auto owner = keymap(key);
       if (owner != world.rank()) {
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding setting argument : ", i);
@@ -349,99 +576,246 @@ namespace ttg_madness {
         // move arguments) and locally
         //      here we know that this will be a remove execution, so we prepare to take rvalues;
         //      send_am will need to separate local and remote paths to deal with this
-        worldobjT::send(owner, &opT::template set_arg<i, Key, const std::remove_reference_t<Value> &>, key, value);
+        send_remote<&opT::template set_arg<i, Key, const std::remove_reference_t<Value> &>>(owner, key, value);
       } else {
-        if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": received value for argument : ", i);
+        set_arg_local<i, Key, Value>(key, std::forward<Value>(value));
+        // N.B. holds no cache entry here, migrating tasks locks the entries of other keys
+        if (migration_enabled) balance_load();
+      }
+    }
 
-        accessorT acc;
-        if (cache.insert(acc, key)) acc->second = new OpArgs(this->priomap(key));  // It will be deleted by the task q
-        OpArgs *args = acc->second;
+    /// sets argument \c i of the task with key \p key , which is executed by this rank
+    /// \param migrated_in whether the task has migrated to this rank (see set_key_migration); such tasks are neither
+    ///        forwarded nor migrated again
+    /// \param ready if not null, the task is appended to \p *ready once ready rather than submitted
+    template <std::size_t i, typename Key, typename Value>
+    void set_arg_local(const Key &key, Value &&value, bool migrated_in = false, std::vector<OpArgs *> *ready = nullptr) {
+      using valueT = typename std::tuple_element<i, input_values_full_tuple_type>::type;  // Should be T or const T
+      static_assert(std::is_same_v<std::decay_t<Value>, std::decay_t<valueT>>,
+                    "Op::set_arg(key,value) given value of type incompatible with Op");
 
-        if (args->nargs[i] == 0) {
-          ttg::print_error(world.rank(), ":", get_name(), " : ", key, ": error argument is already finalized : ", i);
-          throw std::runtime_error("Op::set_arg called for a finalized stream");
+      // a tracked value is shared by the consumers of a send (see detail::copy_scope), the reducer may move from it
+      // only if no other consumer shares it
+      if constexpr (!std::is_lvalue_reference_v<Value> && !ttg::meta::is_void_v<valueT>)
+        if (std::get<i>(input_reducers))
+          if (auto copy = detail::share(static_cast<const std::decay_t<Value> &>(value), true)) {
+            if (copy.use_count() > 1)
+              return set_arg_local<i, Key, const std::decay_t<Value> &>(key, value, migrated_in, ready);
+            std::decay_t<Value> unshared = std::move(*copy);
+            return set_arg_local<i, Key, std::decay_t<Value>>(key, std::move(unshared), migrated_in, ready);
+          }
+
+      if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": received value for argument : ", i);
+
+      // the task of an op with a single nonstreaming input is ready as soon as this value arrives,
+      // hence it is created here and submitted right away, without going through the cache
+      const bool cached = numins > 1 || static_cast<bool>(std::get<i>(input_reducers));
+      accessorT acc;
+      OpArgs *args;
+      if (cached) {
+        if (cache.insert(acc, key)) {
+          // has the task migrated to another rank? forward the value to its new owner
+          if (migration_enabled && !migrated_in && forward_migrated<i>(acc, key, value)) return;
+          acc->second = new OpArgs(this->priomap(key));  // It will be deleted by the task q
+          if (migration_enabled && !migrated_in) add_migration_candidate(key);
         }
+        args = acc->second;
+      } else
+        args = new OpArgs(this->priomap(key));  // It will be deleted by the task q
 
-        auto reducer = std::get<i>(input_reducers);
-        if (reducer) {  // is this a streaming input? reduce the received value
-          // N.B. Right now reductions are done eagerly, without spawning tasks
-          //      this means we must lock
-          args->lock();
-          if constexpr (!ttg::meta::is_void_v<valueT>) {  // for data values
-            // have a value already? if not, set, otherwise reduce
-            if (args->nargs[i] == std::numeric_limits<std::size_t>::max()) {
-              this->get<i, std::decay_t<valueT> &>(args->input_values) = std::forward<Value>(value);
-
-              // now have a value, reset nargs
-              // check if we have a stream size for the op, which has precedence over the global setting.
-              if (args->stream_size[i] != 0) {
-                args->nargs[i] = args->stream_size[i];
-              } else if (static_streamsize[i] != 0) {
-                args->stream_size[i] = static_streamsize[i];
-                args->nargs[i] = static_streamsize[i];
-              } else {
-                args->nargs[i] = 1;
-              }
+      if (args->nargs[i] == 0) {
+        ttg::print_error(world.rank(), ":", get_name(), " : ", key, ": error argument is already finalized : ", i);
+        throw std::runtime_error("Op::set_arg called for a finalized stream");
+      }
+
+      auto &reducer = std::get<i>(input_reducers);
+      // is this a streaming input with a commutative reducer? reduce into this thread's partial result
+      if (!ttg::meta::is_void_v<valueT> && reducer && commutative_reducers[i]) {
+        if constexpr (!ttg::meta::is_void_v<valueT>) {
+          ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
+          if (!reduce_partial<i>(acc, args, std::move(reduced_value))) return;
+          // the stream is complete, acc again holds the cache entry
+        }
+      } else if (reducer) {  // is this a streaming input? reduce the received value
+        // the reducer consumes the value: move it if possible, otherwise copy it before locking
+        [[maybe_unused]] ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
+        // N.B. Right now reductions are done eagerly, without spawning tasks
+        //      this means we must lock
+        args->lock();
+        if constexpr (!ttg::meta::is_void_v<valueT>) {  // for data values
+          // have a value already? if not, set, otherwise reduce
+          if (args->nargs[i] == std::numeric_limits<std::size_t>::max()) {
+            std::get<i>(args->input_values).assign(std::move(reduced_value));
+
+            // now have a value, reset nargs
+            // check if we have a stream size for the op, which has precedence over the global setting.
+            if (args->stream_size[i] != 0) {
+              args->nargs[i] = args->stream_size[i];
+            } else if (static_streamsize[i] != 0) {
+              args->stream_size[i] = static_streamsize[i];
+              args->nargs[i] = static_streamsize[i];
             } else {
-              // Why do we need to move the value here??
-              valueT value_copy = value;  // use constexpr if to avoid making a copy if given nonconst rvalue
-              this->get<i, std::decay_t<valueT> &>(args->input_values) =
-                  std::move(reducer(this->get<i, std::decay_t<valueT> &&>(args->input_values), std::move(value_copy)));
+              args->nargs[i] = 1;
             }
           } else {
-            reducer();  // even if this was a control input, must execute the reducer for possible side effects
-          }
-          // update the counter if the stream is bounded
-          // this assumes that the stream size is set before data starts flowing ... strong-typing streams will solve
-          // this
-          if (args->stream_size[i] != 0) {
-            args->nargs[i]--;
-            if (args->nargs[i] == 0) args->counter--;
+            auto &accumulator = std::get<i>(args->input_values).get_mutable();
+            accumulator = reducer(std::move(accumulator), std::move(reduced_value));
           }
-          args->unlock();
-        } else {                                          // this is a nonstreaming input => set the value
-          if constexpr (!ttg::meta::is_void_v<valueT>) {  // for data values
-            this->get<i, std::decay_t<valueT> &>(args->input_values) = std::forward<Value>(value);
-          }
-          args->nargs[i] = 0;
-          args->counter--;
+        } else {
+          reducer();  // even if this was a control input, must execute the reducer for possible side effects
+        }
+        // update the counter if the stream is bounded
+        // this assumes that the stream size is set before data starts flowing ... strong-typing streams will solve
+        // this
+        if (args->stream_size[i] != 0) {
+          args->nargs[i]--;
+          if (args->nargs[i] == 0) args->counter--;
+        }
+        args->unlock();
+      } else {                                          // this is a nonstreaming input => set the value
+        if constexpr (!ttg::meta::is_void_v<valueT>) {  // for data values
+          std::get<i>(args->input_values).set(std::forward<Value>(value));
         }
+        args->nargs[i] = 0;
+        args->counter--;
+      }
 
-        // ready to run the task?
-        if (args->counter == 0) {
-          if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": submitting task for op ");
-          args->derived = static_cast<derivedT *>(this);
-          args->key = key;
+      // ready to run the task?
+      if (args->counter == 0) {
+        if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": submitting task for op ");
+        args->derived = static_cast<derivedT *>(this);
+        args->key = key;
 
-          using ttg::hash;
-          auto curhash = hash<keyT>{}(key);
-
-          if (curhash == threaddata.key_hash && threaddata.call_depth < 6) {  // Needs to be externally configurable
-
-            // ttg::print("directly invoking:", get_name(), key, curhash, threaddata.key_hash, threaddata.call_depth);
-            opT::threaddata.call_depth++;
-            if constexpr (!ttg::meta::is_void_v<keyT> && !ttg::meta::is_empty_tuple_v<input_values_tuple_type>) {
-              static_cast<derivedT *>(this)->op(key, args->make_input_refs(), output_terminals);  // Runs immediately
-            } else if constexpr (!ttg::meta::is_void_v<keyT> && ttg::meta::is_empty_tuple_v<input_values_tuple_type>) {
-              static_cast<derivedT *>(this)->op(key, output_terminals);  // Runs immediately
-            } else if constexpr (ttg::meta::is_void_v<keyT> && !ttg::meta::is_empty_tuple_v<input_values_tuple_type>) {
-              static_cast<derivedT *>(this)->op(args->make_input_refs(), output_terminals);  // Runs immediately
-            } else if constexpr (ttg::meta::is_void_v<keyT> && ttg::meta::is_empty_tuple_v<input_values_tuple_type>) {
-              static_cast<derivedT *>(this)->op(output_terminals);  // Runs immediately
-            } else
-              abort();
-            opT::threaddata.call_depth--;
+        using ttg::hash;
+        auto curhash = hash<keyT>{}(key);
+
+        // N.B. release the cache entry before executing the task, it may be executed inline
+        if (cached) cache.erase(acc);
+        if (ready)
+          ready->push_back(args);
+        else  // by default execute inline if this op is executing a task with the same key
+          submit_ready_task(args, curhash == threaddata.key_hash && threaddata.call_depth < 6);
+      }
+    }
 
-          } else {
-            // ttg::print("enqueuing task", get_name(), key, curhash, threaddata.key_hash, threaddata.call_depth);
-            world.impl().impl().taskq.add(args);
-          }
+    /// receives input \c i of the task with key \p key , which rank \p from has migrated to this rank
+    template <std::size_t i, typename Key, typename Value>
+    void set_arg_migrated(int from, const Key &key, const Value &value) {
+      {
+        std::scoped_lock lock(migration_mtx);
+        if (std::find(donors.begin(), donors.end(), from) == donors.end()) donors.push_back(from);
+      }
+      set_arg_local<i, Key, const Value &>(key, value, true);
+    }
 
-          cache.erase(acc);
+    /// records the key of a task that waits for inputs as a candidate for migration
+    void add_migration_candidate(const hashable_keyT &key) {
+      std::scoped_lock lock(migration_mtx);
+      // N.B. the keys of tasks that have become ready are dropped lazily, bound their number
+      if (migration_candidates.size() == max_migration_candidates) migration_candidates.pop_front();
+      migration_candidates.push_back(key);
+    }
+
+    /// forwards \p value for input \c i of the task with key \p key to the rank the task has migrated to, if any
+    /// \param acc holds the cache entry just created for \p key ; erased if the task has migrated
+    /// \return true if the task has migrated
+    template <std::size_t i, typename Key, typename Value>
+    bool forward_migrated(accessorT &acc, const Key &key, const Value &value) {
+      int owner;
+      {
+        std::scoped_lock lock(migration_mtx);
+        auto it = migrated.find(key);
+        if (it == migrated.end()) return false;
+        owner = it->second.first;
+        if (--it->second.second == 0) migrated.erase(it);
+      }
+      cache.erase(acc);
+      if (tracing())
+        ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding argument ", i, " to migrated task on rank ",
+                   owner);
+      send_remote<&opT::template set_arg_migrated<i, Key, Value>>(owner, world.rank(), key, value);
+      return true;
+    }
+
+    /// sends input \c i of task \p args , if received already, to rank \p thief
+    template <std::size_t i>
+    void migrate_input(int thief, const hashable_keyT &key, OpArgs *args) {
+      using valueT = std::tuple_element_t<i, input_values_full_tuple_type>;
+      if (args->nargs[i] != 0) return;
+      if constexpr (i < std::tuple_size_v<input_values_tuple_type>)
+        send_remote<&opT::template set_arg_migrated<i, keyT, valueT>>(thief, world.rank(), key,
+                                                                        std::get<i>(args->input_values).get());
+      else  // the control input
+        send_remote<&opT::template set_arg_migrated<i, keyT, valueT>>(thief, world.rank(), key, valueT{});
+    }
+
+    template <std::size_t... Is>
+    void migrate_inputs(int thief, const hashable_keyT &key, OpArgs *args, std::index_sequence<Is...>) {
+      (migrate_input<Is>(thief, key, args), ...);
+    }
+
+    /// hands up to \p n tasks that wait for inputs, oldest first, over to rank \p thief : the inputs received so far
+    /// are sent to \p thief , the inputs that arrive later will be forwarded to it
+    /// \return the number of migrated tasks
+    std::size_t migrate_tasks(int thief, std::size_t n) {
+      std::size_t nmigrated = 0;
+      while (nmigrated != n) {
+        std::optional<hashable_keyT> key;
+        {
+          std::scoped_lock lock(migration_mtx);
+          if (migration_candidates.empty()) break;
+          key.emplace(std::move(migration_candidates.front()));
+          migration_candidates.pop_front();
         }
+        accessorT acc;
+        if (!cache.find(acc, *key)) continue;  // the task has become ready already
+        OpArgs *args = acc->second;
+        {
+          std::scoped_lock lock(migration_mtx);
+          migrated.emplace(*key, std::make_pair(thief, args->counter));
+        }
+        if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", *key, ": migrating task to rank ", thief);
+        migrate_inputs(thief, *key, args, std::make_index_sequence<numins>{});
+        cache.erase(acc);
+        delete args;
+        ++nmigrated;
       }
+      return nmigrated;
+    }
+
+    /// @return true if any input of this op is streaming; tasks with streaming inputs are not migrated
+    bool has_streaming_inputs() const {
+      return std::apply([](const auto &...reducers) { return (static_cast<bool>(reducers) || ...); }, input_reducers);
     }
 
+    /// migrates tasks to an idle rank if this rank is overloaded, or tells the ranks that migrated tasks to this rank
+    /// that it is idle, as judged by the number of pending tasks of this rank (of all ops)
+    /// \note must not be called while holding a cache entry
+    void balance_load() {
+      const std::size_t backlog = world.impl().impl().taskq.size();
+      if (backlog < migration_idle) {
+        std::vector<int> ranks;
+        {
+          std::scoped_lock lock(migration_mtx);
+          ranks.swap(donors);
+        }
+        for (auto r : ranks) send_remote<&opT::set_rank_idle>(r, world.rank());
+      } else if (backlog > migration_overloaded && !has_streaming_inputs() && !migrating.exchange(true)) {
+        const int nranks = world.size();
+        for (int r = 0; r != nranks; ++r) {
+          const int thief = (next_thief + r) % nranks;
+          if (thief == world.rank() || !idle_ranks[thief].exchange(false)) continue;
+          next_thief = (thief + 1) % nranks;
+          if (migrate_tasks(thief, migration_batch) == 0) idle_ranks[thief] = true;  // nothing to migrate
+          break;
+        }
+        migrating = false;
+      }
+    }
+
+    /// marks rank \p r as ready to receive migrated tasks
+    void set_rank_idle(int r) { idle_ranks[r] = true; }
+
     // case 2
     template <std::size_t i, typename Key, typename Value>
     std::enable_if_t<!ttg::meta::is_void_v<Key> && std::is_void_v<Value>, void> set_arg(const Key &key) {
@@ -460,21 +834,45 @@ namespace ttg_madness {
       if (owner != world.rank()) {
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : forwarding setting argument : ", i);
         // CAVEAT see comment above in set_arg re:
-        worldobjT::send(owner, &opT::template set_arg<i, keyT, const std::remove_reference_t<Value> &>, value);
+        send_remote<&opT::template set_arg<i, keyT, const std::remove_reference_t<Value> &>>(owner, value);
       } else {
+        // see case 1 re: tracked values
+        if constexpr (!std::is_lvalue_reference_v<Value> && !ttg::meta::is_void_v<valueT>)
+          if (std::get<i>(input_reducers))
+            if (auto copy = detail::share(static_cast<const std::decay_t<Value> &>(value), true)) {
+              if (copy.use_count() > 1) return set_arg<i, Key, const std::decay_t<Value> &>(value);
+              std::decay_t<Value> unshared = std::move(*copy);
+              return set_arg<i, Key, std::decay_t<Value>>(std::move(unshared));
+            }
+
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : received value for argument : ", i);
 
+        // see case 1 re: skipping the cache
+        const bool cached = numins > 1 || static_cast<bool>(std::get<i>(input_reducers));
         accessorT acc;
-        if (cache.insert(acc, 0)) acc->second = new OpArgs();  // It will be deleted by the task q
-        OpArgs *args = acc->second;
+        OpArgs *args;
+        if (cached) {
+          if (cache.insert(acc, 0)) acc->second = new OpArgs();  // It will be deleted by the task q
+          args = acc->second;
+        } else
+          args = new OpArgs();  // It will be deleted by the task q
 
         if (args->nargs[i] == 0) {
           ttg::print_error(world.rank(), ":", get_name(), " : error argument is already finalized : ", i);
           throw std::runtime_error("Op::set_arg called for a finalized stream");
         }
 
-        auto reducer = std::get<i>(input_reducers);
-        if (reducer) {  // is this a streaming input? reduce the received value
+        auto &reducer = std::get<i>(input_reducers);
+        // is this a streaming input with a commutative reducer? reduce into this thread's partial result
+        if (!ttg::meta::is_void_v<valueT> && reducer && commutative_reducers[i]) {
+          if constexpr (!ttg::meta::is_void_v<valueT>) {
+            ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
+            if (!reduce_partial<i>(acc, args, std::move(reduced_value))) return;
+            // the stream is complete, acc again holds the cache entry
+          }
+        } else if (reducer) {  // is this a streaming input? reduce the received value
+          // the reducer consumes the value: move it if possible, otherwise copy it before locking
+          ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
           // N.B. Right now reductions are done eagerly, without spawning tasks
           //      this means we must lock
           args->lock();
@@ -483,7 +881,7 @@ namespace ttg_madness {
           }
           // have a value already? if not, set, otherwise reduce
           if (args->nargs[i] == std::numeric_limits<std::size_t>::max()) {
-            this->get<i, std::decay_t<valueT> &>(args->input_values) = std::forward<Value>(value);
+            std::get<i>(args->input_values).assign(std::move(reduced_value));
             // now have a value, reset nargs
             if (args->stream_size[i] != 0) {
               args->nargs[i] = args->stream_size[i];
@@ -494,10 +892,8 @@ namespace ttg_madness {
               args->nargs[i] = 1;
             }
           } else {
-            valueT value_copy = value;  // use constexpr if to avoid making a copy if given nonconst rvalue
-            // once Future<>::operator= semantics is cleaned up will avoid Future<>::get()
-            this->get<i, std::decay_t<valueT> &>(args->input_values) =
-                std::move(reducer(this->get<i, std::decay_t<valueT> &&>(args->input_values), std::move(value_copy)));
+            auto &accumulator = std::get<i>(args->input_values).get_mutable();
+            accumulator = reducer(std::move(accumulator), std::move(reduced_value));
           }
           // update the counter if the stream is bounded
           // this assumes that the stream size is set before data starts flowing ... strong-typing streams will solve
@@ -512,7 +908,7 @@ namespace ttg_madness {
           }
           args->unlock();
         } else {  // this is a nonstreaming input => set the value
-          this->get<i, std::decay_t<valueT> &>(args->input_values) = std::forward<Value>(value);
+          std::get<i>(args->input_values).set(std::forward<Value>(value));
           args->nargs[i] = 0;
           args->counter--;
         }
@@ -522,9 +918,8 @@ namespace ttg_madness {
           if (tracing()) ttg::print(world.rank(), ":", get_name(), " : submitting task for op ");
           args->derived = static_cast<derivedT *>(this);
 
-          world.impl().impl().taskq.add(args);
-
-          cache.erase(acc);
+          if (cached) cache.erase(acc);
+          submit_ready_task(args);
         }
       }
     }
@@ -544,20 +939,16 @@ namespace ttg_madness {
 
       if (owner != world.rank()) {
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding no-arg task: ");
-        worldobjT::send(owner, &opT::set_arg<keyT>, key);
+        send_remote<&opT::set_arg<keyT>>(owner, key);
       } else {
-        accessorT acc;
-        if (cache.insert(acc, key)) acc->second = new OpArgs(this->priomap(key));  // It will be deleted by the task q
-        OpArgs *args = acc->second;
+        // no data inputs => the task is ready, no need to go through the cache
+        auto args = new OpArgs(this->priomap(key));  // It will be deleted by the task q
 
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": submitting task for op ");
         args->derived = static_cast<derivedT *>(this);
         args->key = key;
 
-        world.impl().impl().taskq.add(args);
-        // static_cast<derivedT*>(this)->op(key, std::move(args->t), output_terminals);// runs immediately
-
-        cache.erase(acc);
+        submit_ready_task(args);
       }
     }
 
@@ -570,15 +961,68 @@ namespace ttg_madness {
 
       if (owner != world.rank()) {
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : forwarding no-arg task: ");
-        worldobjT::send(owner, &opT::set_arg<keyT>);
+        send_remote<&opT::set_arg<keyT>>(owner);
       } else {
         auto task = new OpArgs();  // It will be deleted by the task q
 
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : submitting task for op ");
         task->derived = static_cast<derivedT *>(this);
 
-        world.impl().impl().taskq.add(task);
+        submit_ready_task(task);
+      }
+    }
+
+    // sets argument i of the tasks for every key in keylist to value
+    // N.B. all keys are expected to be local, this is the receiving end of broadcast_arg
+    template <std::size_t i, typename Key, typename Value>
+    std::enable_if_t<!ttg::meta::is_void_v<Key> && !std::is_void_v<std::decay_t<Value>>, void> set_arg_keylist(
+        const std::vector<Key> &keylist, const Value &value) {
+      detail::copy_scope scope;  // the tasks share a single copy of value
+      scope.track(value);
+      set_arg_local_keylist<i>(keylist.begin(), keylist.end(), value);
+    }
+
+    /// sets argument \c i of the local tasks with keys in [\p first , \p last ) to \p value : the tasks are created
+    /// as a batch, and those that become ready are submitted after all of them have received \p value
+    template <std::size_t i, typename Iterator, typename Value>
+    void set_arg_local_keylist(Iterator first, Iterator last, const Value &value) {
+      std::vector<OpArgs *> ready;
+      ready.reserve(std::distance(first, last));
+      for (; first != last; ++first) {
+        assert(keymap(*first) == world.rank());
+        set_arg_local<i, keyT, const Value &>(*first, value, false, &ready);
       }
+      for (auto *args : ready) submit_ready_task(args);
+      // N.B. holds no cache entry here, see set_arg
+      if (migration_enabled) balance_load();
+    }
+
+    // sets argument i of the tasks for every key in keylist to value: keys are grouped by owner, every remote owner
+    // receives a single message carrying its keys and one copy of value
+    template <std::size_t i, typename Key, typename Value>
+    std::enable_if_t<!ttg::meta::is_void_v<Key> && !std::is_void_v<std::decay_t<Value>>, void> broadcast_arg(
+        const ttg::span<const Key> &keylist, const Value &value) {
+      const int rank = world.rank();
+      std::map<int, std::vector<Key>> remote_keylists;
+      std::vector<Key> local_keylist;
+      for (auto &&key : keylist) {
+        const int owner = keymap(key);
+        if (owner == rank)
+          local_keylist.push_back(key);
+        else
+          remote_keylists[owner].push_back(key);
+      }
+      for (auto &&[owner, keys] : remote_keylists) {
+        if (tracing())
+          ttg::print(world.rank(), ":", get_name(), " : forwarding setting argument : ", i, " for ", keys.size(),
+                     " keys to rank ", owner);
+        send_remote<&opT::template set_arg_keylist<i, Key, Value>>(owner, keys, value);
+      }
+      // local tasks are created after sending the remote messages to overlap communication; they share a single copy
+      // of value
+      detail::copy_scope scope;
+      if (!detail::is_tracked(value)) scope.track(value);
+      set_arg_local_keylist<i>(local_keylist.begin(), local_keylist.end(), value);
     }
 
     // Used by invoke to set all arguments associated with a task
@@ -604,7 +1048,7 @@ namespace ttg_madness {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : forwarding stream size for terminal ", i);
         }
-        worldobjT::send(owner, &opT::template set_argstream_size<i, true>, size);
+        send_remote<&opT::template set_argstream_size<i, true>>(owner, size);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : setting stream size to ", size, " for terminal ", i);
@@ -631,7 +1075,16 @@ namespace ttg_madness {
         // commit changes
         args->stream_size[i] = size;
 
+        // the values of a commutative stream are counted by its partial results, the stream may be complete already
+        auto &partials = std::get<i>(args->partials);
+        const bool complete = partials && partials->set_goal(size) && complete_partials<i>(args);
         args->unlock();
+        if (complete && args->counter == 0) {
+          if (tracing()) ttg::print(world.rank(), ":", get_name(), " : submitting task for op ");
+          args->derived = static_cast<derivedT *>(this);
+          cache.erase(acc);
+          submit_ready_task(args);
+        }
       }
     }
 
@@ -668,7 +1121,7 @@ namespace ttg_madness {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding stream size for terminal ", i);
         }
-        worldobjT::send(owner, &opT::template set_argstream_size<i>, key, size);
+        send_remote<&opT::template set_argstream_size<i>>(owner, key, size);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": setting stream size for terminal ", i);
@@ -695,7 +1148,17 @@ namespace ttg_madness {
         // commit changes
         args->stream_size[i] = size;
 
+        // the values of a commutative stream are counted by its partial results, the stream may be complete already
+        auto &partials = std::get<i>(args->partials);
+        const bool complete = partials && partials->set_goal(size) && complete_partials<i>(args);
         args->unlock();
+        if (complete && args->counter == 0) {
+          if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": submitting task for op ");
+          args->derived = static_cast<derivedT *>(this);
+          args->key = key;
+          cache.erase(acc);
+          submit_ready_task(args);
+        }
       }
     }
 
@@ -711,7 +1174,7 @@ namespace ttg_madness {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding stream finalize for terminal ", i);
         }
-        worldobjT::send(owner, &opT::template finalize_argstream<i>, key);
+        send_remote<&opT::template finalize_argstream<i>>(owner, key);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": finalizing stream for terminal ", i);
@@ -736,8 +1199,13 @@ namespace ttg_madness {
         }
 
         // commit changes
-        args->nargs[i] = 0;
-        args->counter--;
+        if (auto &partials = std::get<i>(args->partials); commutative_reducers[i] && partials) {
+          // contributions may be in flight, then the last one out completes the stream
+          if (!partials->close() || !complete_partials<i>(args)) return;
+        } else {
+          args->nargs[i] = 0;
+          args->counter--;
+        }
         // ready to run the task?
         if (args->counter == 0) {
           if (tracing()) {
@@ -746,7 +1214,8 @@ namespace ttg_madness {
           args->derived = static_cast<derivedT *>(this);
           args->key = key;
 
-          world.impl().impl().taskq.add(args);
+          this->count_task_created();
+          world.impl().submit(args, args->priority);
           // static_cast<derivedT*>(this)->op(key, std::move(args->t), output_terminals); // Runs immediately
 
           cache.erase(acc);
@@ -766,7 +1235,7 @@ namespace ttg_madness {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : forwarding stream finalize for terminal ", i);
         }
-        worldobjT::send(owner, &opT::template finalize_argstream<i, true>);
+        send_remote<&opT::template finalize_argstream<i, true>>(owner);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : finalizing stream for terminal ", i);
@@ -791,8 +1260,13 @@ namespace ttg_madness {
         }
 
         // commit changes
-        args->nargs[i] = 0;
-        args->counter--;
+        if (auto &partials = std::get<i>(args->partials); commutative_reducers[i] && partials) {
+          // contributions may be in flight, then the last one out completes the stream
+          if (!partials->close() || !complete_partials<i>(args)) return;
+        } else {
+          args->nargs[i] = 0;
+          args->counter--;
+        }
         // ready to run the task?
         if (args->counter == 0) {
           if (tracing()) {
@@ -800,7 +1274,8 @@ namespace ttg_madness {
           }
           args->derived = static_cast<derivedT *>(this);
 
-          world.impl().impl().taskq.add(args);
+          this->count_task_created();
+          world.impl().submit(args, args->priority);
           // static_cast<derivedT*>(this)->op(key, std::move(args->t), output_terminals); // Runs immediately
 
           cache.erase(acc);
@@ -841,9 +1316,20 @@ namespace ttg_madness {
         auto send_callback = [this](const keyT &key, const valueT &value) {
           set_arg<i, keyT, const valueT &>(key, value);
         };
+        auto broadcast_callback = [this](const ttg::span<const keyT> &keylist, const valueT &value) {
+          broadcast_arg<i, keyT, valueT>(keylist, value);
+        };
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
-        input.set_callback(send_callback, move_callback, {}, setsize_callback, finalize_callback);
+        input.set_callback(send_callback, move_callback, broadcast_callback, setsize_callback, finalize_callback);
+        input.set_direct_callback(
+            this,
+            [](void *op, const keyT &key, const valueT &value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, const valueT &>(key, value);
+            },
+            [](void *op, const keyT &key, valueT &&value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, valueT>(key, std::forward<valueT>(value));
+            });
       }
       //////////////////////////////////////////////////////////////////
       // case 4: void key, nonvoid value
@@ -855,6 +1341,14 @@ namespace ttg_madness {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, move_callback, {}, setsize_callback, finalize_callback);
+        input.set_direct_callback(
+            this,
+            [](void *op, const valueT &value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, const valueT &>(value);
+            },
+            [](void *op, valueT &&value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, valueT>(std::forward<valueT>(value));
+            });
       }
       //////////////////////////////////////////////////////////////////
       // case 2: nonvoid key, void value, mixed inputs
@@ -865,6 +1359,8 @@ namespace ttg_madness {
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op, const keyT &key) { static_cast<Op *>(op)->template set_arg<i, keyT, void>(key); };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 5: void key, void value, mixed inputs
@@ -875,6 +1371,8 @@ namespace ttg_madness {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op) { static_cast<Op *>(op)->template set_arg<i, keyT, void>(); };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 3: nonvoid key, void value, no inputs
@@ -885,6 +1383,8 @@ namespace ttg_madness {
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op, const keyT &key) { static_cast<Op *>(op)->template set_arg<keyT>(key); };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 6: void key, void value, no inputs
@@ -895,6 +1395,8 @@ namespace ttg_madness {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op) { static_cast<Op *>(op)->template set_arg<keyT>(); };
+        input.set_direct_callback(this, send_fn, send_fn);
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : set callbacks for terminal ", input.get_name(),
                      " assuming void {key,value} and no input");
@@ -948,7 +1450,7 @@ namespace ttg_madness {
         , keymap(std::is_same<keymapT, ttg::detail::default_keymap<keyT>>::value
                      ? decltype(keymap)(ttg::detail::default_keymap<keyT>(world))
                      : decltype(keymap)(std::forward<keymapT>(keymap_)))
-        , priomap(decltype(keymap)(std::forward<priomapT>(priomap_))) {
+        , priomap(decltype(priomap)(std::forward<priomapT>(priomap_))) {
       // Cannot call these in base constructor since terminals not yet constructed
       if (innames.size() != std::tuple_size<input_terminals_type>::value) {
         ttg::print_error(world.rank(), ":", get_name(), "#input_names", innames.size(), "!= #input_terminals",
@@ -984,7 +1486,7 @@ namespace ttg_madness {
         , keymap(std::is_same<keymapT, ttg::detail::default_keymap<keyT>>::value
                      ? decltype(keymap)(ttg::detail::default_keymap<keyT>(world))
                      : decltype(keymap)(std::forward<keymapT>(keymap_)))
-        , priomap(decltype(keymap)(std::forward<priomapT>(priomap_))) {
+        , priomap(decltype(priomap)(std::forward<priomapT>(priomap_))) {
       // Cannot call in base constructor since terminals not yet constructed
       if (innames.size() != std::tuple_size<input_terminals_type>::value) {
         ttg::print_error(world.rank(), ":", get_name(), "#input_names", innames.size(), "!= #input_terminals",
@@ -1035,12 +1537,18 @@ namespace ttg_madness {
       }
     }
 
+    /// sets the reducer of streaming input \c i
+    /// \param commutative if true, the reducer is also commutative, hence each thread may reduce the values it receives
+    ///        into its own partial result and partial results are combined once the stream is complete; this avoids
+    ///        contention on high-fan-in streams but requires the stream size to be set before values start flowing
+    ///        (or the stream to be finalized)
     template <std::size_t i, typename Reducer>
-    void set_input_reducer(Reducer &&reducer) {
+    void set_input_reducer(Reducer &&reducer, bool commutative = false) {
       if (tracing()) {
         ttg::print(world.rank(), ":", get_name(), " : setting reducer for terminal ", i);
       }
       std::get<i>(input_reducers) = reducer;
+      commutative_reducers[i] = commutative;
     }
 
     template <typename Keymap>
@@ -1058,9 +1566,43 @@ namespace ttg_madness {
       priomap = pm;
     }
 
+    auto get_threadmap(void) const { return threadmap; }
+
+    /// Enables the migration of tasks between ranks to balance their load (collective: call on every rank before
+    /// the op receives any values).
+    /// A rank with more than \p overloaded pending tasks (of all ops) hands tasks of this op that still wait for some
+    /// of their inputs, together with the inputs received so far, over to a rank with fewer than \p idle pending
+    /// tasks. The rank given by the keymap then forwards the inputs that arrive later, hence senders need not know
+    /// where a task has migrated to. A rank that has received tasks tells the ranks that sent them when it is idle
+    /// again. Only tasks of ops with keys, at least two inputs, and no streaming inputs migrate, and only once.
+    /// \param enable whether to migrate tasks
+    /// \param overloaded the backlog above which a rank is overloaded; 0 = 4 times the number of threads
+    /// \param idle the backlog below which a rank is idle; 0 = the number of threads
+    /// \param batch the maximum number of tasks migrated at once
+    void set_key_migration(bool enable, std::size_t overloaded = 0, std::size_t idle = 0, std::size_t batch = 16) {
+      const std::size_t nthreads = ::madness::ThreadPool::size();
+      migration_enabled = enable && !ttg::meta::is_void_v<keyT> && numins > 1;
+      migration_overloaded = overloaded != 0 ? overloaded : 4 * nthreads;
+      migration_idle = idle != 0 ? idle : nthreads;
+      migration_batch = batch;
+      const int nranks = world.size();
+      idle_ranks = std::make_unique<std::atomic<bool>[]>(nranks);
+      for (int r = 0; r != nranks; ++r) idle_ranks[r] = r != world.rank();
+    }
+
+    /// Set the thread map, mapping a Key to the index of the worker thread that should execute the task, or to a
+    /// negative value for no preference. This is a hint that the MADNESS backend ignores: its thread pool has no
+    /// per-thread task queues (see ttg::runtime_traits::supports_threadmap).
+    template <typename Threadmap>
+    void set_threadmap(Threadmap &&tm) {
+      threadmap = tm;
+    }
+
     /// implementation of OpBase::make_executable()
     void make_executable() {
       this->process_pending();
+      // build the devirtualized fan-out plans of the outputs, see ttg::Out::make_executable
+      std::apply([](auto &...outputs) { (outputs.make_executable(), ...); }, output_terminals);
       OpBase::make_executable();
     }
 
@@ -1141,4 +1683,45 @@ namespace ttg_madness {
 
 #include "ttg/madness/watch.h"
 
+/**
+ * The MADNESS backend lets the local consumers of a value passed to send/broadcast share a single reference-counted
+ * copy of it (see ttg_madness::detail::data_copy): an rvalue is moved into the shared copy right away, an lvalue is
+ * copied by its first local consumer, hence values that only travel to other ranks are not copied at all.
+ * The read-only inputs of the task that is executing are shared as they are.
+ */
+template <>
+struct ttg::detail::value_copy_handler<ttg::Runtime::MADWorld> {
+ private:
+  ttg_madness::detail::copy_scope scope;
+
+ public:
+  template <typename Value>
+  inline Value &&operator()(Value &&value) {
+    if constexpr (std::is_const_v<Value>) {  // cannot move from a const rvalue, treat it as a const lvalue
+      (*this)(static_cast<const Value &>(value));
+      return std::move(value);
+    } else if constexpr (ttg_madness::detail::is_shared_v<Value>) {
+      auto copy = std::make_shared<Value>(std::move(value));
+      Value &copy_ref = *copy;
+      scope.track(std::move(copy));
+      return std::move(copy_ref);
+    } else
+      return std::move(value);
+  }
+
+  template <typename Value>
+  inline const Value &operator()(const Value &value) {
+    if (!ttg_madness::detail::is_tracked(value)) scope.track(value);
+    return value;
+  }
+
+  /* the user may modify non-const data after send/broadcast, hence the consumers of a non-const lvalue share a copy
+   * made for this send, even if it is a tracked value already */
+  template <typename Value, typename Enabler = std::enable_if_t<!std::is_const_v<Value>>>
+  inline Value &operator()(Value &value) {
+    scope.track(std::as_const(value));
+    return value;
+  }
+};
+
 #endif  // MADNESS_TTG_H_INCLUDED
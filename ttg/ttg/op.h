@@ -1,8 +1,10 @@
 #ifndef TTG_UTIL_OP_H
 #define TTG_UTIL_OP_H
 
-#include <vector>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "ttg/fwd.h"
 
@@ -36,7 +38,7 @@ namespace ttg {
                 const output_terminals_type &outs,  // tuple of pointers to output terminals
                 const std::string &name = "compositeop")
         : OpBase(name, numins, numouts), ops(std::forward<opsT>(ops_take_ownership)), ins(ins), outs(outs) {
-      if (ops.size() == 0) throw name + ":CompositeOp: need to wrap at least one op";  // see fence
+      if (ops.size() == 0) throw name + ":CompositeOp: need to wrap at least one op";
 
       set_is_composite(true);
       for (auto &op : ops) op->set_is_within_composite(true, this);
@@ -60,7 +62,21 @@ namespace ttg {
 
     OpBase *get_op(std::size_t i) { return ops.at(i).get(); }
 
-    void fence() { ops[0]->fence(); }
+    /// Waits for the ops of this composite to be completed (collective); other ops may keep executing
+    void fence() { ttg_fence(get_world(), std::vector<OpBase *>{this}); }
+
+    /// @return the world of the wrapped ops
+    ttg::World get_world() const override { return ops.front()->get_world(); }
+
+    /// @return the activity of the ops of this composite, see OpBase::activity
+    std::array<std::uint64_t, 4> activity() const override {
+      std::array<std::uint64_t, 4> result = {};
+      for (auto &op : ops) {
+        const auto activity = op->activity();
+        for (std::size_t i = 0; i != result.size(); ++i) result[i] += activity[i];
+      }
+      return result;
+    }
 
     void make_executable() {
       for (auto &op : ops) op->make_executable();
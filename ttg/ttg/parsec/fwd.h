@@ -3,7 +3,9 @@
 
 #include "ttg/fwd.h"
 
+#include <functional>
 #include <future>
+#include <vector>
 
 namespace ttg_parsec {
 
@@ -25,6 +27,12 @@ namespace ttg_parsec {
 
   inline void ttg_fence(ttg::World world);
 
+  inline std::future<void> ttg_fence_async(ttg::World world);
+
+  inline void ttg_fence(ttg::World world, const std::vector<ttg::OpBase *> &ops);
+
+  inline std::future<void> ttg_fence_async(ttg::World world, std::vector<ttg::OpBase *> ops);
+
   template <typename T>
   inline void ttg_register_ptr(ttg::World world, const std::shared_ptr<T> &ptr);
 
@@ -35,12 +43,19 @@ namespace ttg_parsec {
 
   inline ttg::Edge<> &ttg_ctl_edge(ttg::World world);
 
-  inline void ttg_sum(ttg::World world, double &value);
+  template <typename T, typename Op = std::plus<T>>
+  std::future<T> ttg_allreduce(ttg::World world, const T &value, Op = Op{});
+
+  template <typename T>
+  inline void ttg_sum(ttg::World world, T &value);
+
+  template <typename T>
+  std::future<T> ttg_broadcast_async(ttg::World world, T data, int source_rank);
 
   /// broadcast
   /// @tparam T a serializable type
   template <typename T>
-  static void ttg_broadcast(ttg::World world, T &data, int source_rank);
+  void ttg_broadcast(ttg::World world, T &data, int source_rank);
 
 }  // namespace ttg_parsec
 
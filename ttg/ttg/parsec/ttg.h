@@ -22,6 +22,7 @@
 #include "ttg/terminal.h"
 #include "ttg/util/hash.h"
 #include "ttg/util/meta.h"
+#include "ttg/util/partial_reduction.h"
 #include "ttg/util/print.h"
 #include "ttg/util/trace.h"
 
@@ -29,8 +30,11 @@
 
 #include "ttg/parsec/fwd.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <experimental/type_traits>
 #include <functional>
 #include <future>
@@ -53,6 +57,7 @@
 #include <parsec/parsec_comm_engine.h>
 #include <parsec/parsec_internal.h>
 #include <parsec/scheduling.h>
+#include <cstddef>
 #include <cstdlib>
 #include <cstring>
 
@@ -69,19 +74,87 @@ int parsec_add_fetch_runtime_task(parsec_taskpool_t *tp, int tasks);
 namespace ttg_parsec {
   inline thread_local parsec_task_t *parsec_ttg_caller;
   inline thread_local parsec_execution_stream_t *parsec_ttg_es;
+  inline thread_local std::size_t parsec_ttg_inline_depth = 0;  // # of tasks executed inline on this thread's stack
 
   typedef void (*static_set_arg_fct_type)(void *, size_t, ttg::OpBase *);
   typedef std::pair<static_set_arg_fct_type, ttg::OpBase *> static_set_arg_fct_call_t;
-  inline std::map<uint64_t, static_set_arg_fct_call_t> static_id_to_op_map;
-  inline std::mutex static_map_mutex;
   typedef std::tuple<int, void *, size_t> static_set_arg_fct_arg_t;
-  inline std::multimap<uint64_t, static_set_arg_fct_arg_t> delayed_unpack_actions;
+
+  namespace detail {
+
+    /// An entry of the op dispatch table
+    struct static_op_slot_t {
+      std::atomic<bool> registered = false;
+      static_set_arg_fct_call_t call = {nullptr, nullptr};  // valid once registered is set
+      std::mutex mutex;                                     // protects delayed and the registration
+      std::vector<static_set_arg_fct_arg_t> delayed;        // messages received before the op was registered
+
+      /// @return true if the op is registered; otherwise a copy of the message is saved for delivery
+      ///         upon registration and false is returned
+      bool registered_or_delay(uint64_t op_id, void *data, std::size_t size, int src_rank) {
+        if (registered.load(std::memory_order_acquire)) return true;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (registered.load(std::memory_order_relaxed)) return true;
+        void *data_cpy = malloc(size);
+        assert(data_cpy != 0);
+        memcpy(data_cpy, data, size);
+        if (ttg::tracing()) {
+          ttg::print("ttg_parsec(", ttg_default_execution_context().rank(), ") Delaying delivery of message (",
+                     src_rank, ", ", op_id, ", ", data_cpy, ", ", size, ")");
+        }
+        delayed.emplace_back(src_rank, data_cpy, size);
+        return false;
+      }
+    };
+
+    /// Dispatch table of the ops indexed by their instance id (instance ids are dense).
+    /// Slots live in segments of doubling size that are allocated on first use and never move,
+    /// so lookups are lock-free.
+    class static_op_table {
+      static constexpr uint64_t base_size = 256;
+      static constexpr std::size_t max_segments = 48;
+      std::array<std::atomic<static_op_slot_t *>, max_segments> segments = {};
+
+     public:
+      static_op_table() = default;
+      static_op_table(const static_op_table &) = delete;
+      static_op_table &operator=(const static_op_table &) = delete;
+
+      ~static_op_table() {
+        for (auto &segment : segments) delete[] segment.load();
+      }
+
+      /// @return the slot of op \p op_id
+      static_op_slot_t &slot(uint64_t op_id) {
+        /* segment s holds ids [(2^s - 1) * base_size, (2^(s+1) - 1) * base_size) */
+        std::size_t s = 0;
+        for (uint64_t idx = op_id / base_size + 1; idx > 1; idx >>= 1) ++s;
+        assert(s < max_segments);
+        const uint64_t begin = ((uint64_t(1) << s) - 1) * base_size;
+        static_op_slot_t *segment = segments[s].load(std::memory_order_acquire);
+        if (nullptr == segment) {
+          static_op_slot_t *new_segment = new static_op_slot_t[base_size << s];
+          if (segments[s].compare_exchange_strong(segment, new_segment, std::memory_order_acq_rel)) {
+            segment = new_segment;
+          } else {
+            delete[] new_segment;
+          }
+        }
+        return segment[op_id - begin];
+      }
+    };
+
+  }  // namespace detail
+
+  inline detail::static_op_table static_id_to_op_map;
 
   struct msg_header_t {
     typedef enum {
       MSG_SET_ARG = 0,
       MSG_SET_ARGSTREAM_SIZE = 1,
-      MSG_FINALIZE_ARGSTREAM_SIZE = 2
+      MSG_FINALIZE_ARGSTREAM_SIZE = 2,
+      MSG_SET_ARG_RENDEZVOUS = 3,
+      MSG_BATCH = 4
     } fn_id_t;
     uint32_t taskpool_id;
     uint64_t op_id;
@@ -90,37 +163,141 @@ namespace ttg_parsec {
     int num_keys;
   };
 
+  class WorldImpl;
+
   namespace detail {
 
+    /// Coalesces small active messages to the same destination rank into batches (see
+    /// WorldImpl::set_msg_aggregation). Each thread owns its batches; they are flushed when full, and before the
+    /// thread blocks waiting for a collective (see ttg_allreduce) or a fence. Batches whose oldest message exceeds the
+    /// configured delay are flushed by the next append to them, or by flush_expired, which a recurring PaRSEC task
+    /// runs while any batch is pending (see WorldImpl::schedule_flusher); hence batches of a thread that stops
+    /// sending, e.g. a worker that runs out of tasks or the main thread after Op::invoke, are not held back, and the
+    /// taskpool cannot terminate while a batch is pending.
+    /// Batch layout: [msg_header_t (MSG_BATCH, num_keys = number of messages)][size, message]...
+    /// with each message starting at a multiple of 8 bytes.
+    class msg_aggregator {
+      struct batch_t {
+        std::unique_ptr<unsigned char[]> buffer;
+        std::size_t capacity = 0;
+        std::size_t size = 0;  // bytes in use, including the batch header
+        std::chrono::steady_clock::time_point first_msg_time;
+      };
+      WorldImpl *world = nullptr;
+      std::vector<batch_t> batches;  // indexed by destination rank
+      std::size_t num_nonempty = 0;
+      std::mutex mtx;  // guards the above; contended only when the communication thread flushes expired batches
+
+      /// the aggregators of all threads, for flush_expired
+      struct registry_t {
+        std::mutex mtx;
+        std::vector<msg_aggregator *> aggregators;
+        std::atomic<std::size_t> num_nonempty = 0;  // # of nonempty batches of all threads
+      };
+      static registry_t &registry() {
+        static registry_t r;
+        return r;
+      }
+
+      void flush_unlocked(int owner);
+
+      void flush_unlocked() {
+        if (0 == num_nonempty) return;
+        for (int owner = 0; owner < static_cast<int>(batches.size()); ++owner) flush_unlocked(owner);
+      }
+
+      msg_aggregator() {
+        auto &r = registry();
+        std::scoped_lock lock(r.mtx);
+        r.aggregators.push_back(this);
+      }
+
+     public:
+      static constexpr std::size_t record_size(std::size_t msg_size) {
+        return sizeof(uint64_t) + ((msg_size + 7) & ~std::size_t(7));
+      }
+
+      /// @return the aggregator of the calling thread
+      static msg_aggregator &instance() {
+        static thread_local msg_aggregator aggregator;
+        return aggregator;
+      }
+
+      /// appends message \p msg of \p size bytes to the batch for rank \p owner
+      /// @return false if the message is too large to be coalesced and must be sent directly;
+      ///         the pending batch for \p owner is flushed first to preserve the message order
+      bool append(WorldImpl &world, int owner, const void *msg, std::size_t size);
+
+      /// sends all pending batches
+      void flush() {
+        std::scoped_lock lock(mtx);
+        flush_unlocked();
+      }
+
+      /// sends the batches of all threads whose oldest message exceeds the configured delay; called by the flush task
+      /// (see WorldImpl::schedule_flusher) and by the communication thread as it receives messages, skips the
+      /// aggregators that are in use
+      static void flush_expired();
+
+      /// @return the number of nonempty batches of all threads
+      static std::size_t num_pending() { return registry().num_nonempty.load(); }
+
+      ~msg_aggregator() {
+        assert(0 == num_nonempty);
+        auto &r = registry();
+        std::scoped_lock lock(r.mtx);
+        r.aggregators.erase(std::find(r.aggregators.begin(), r.aggregators.end(), this));
+      }
+    };
+
+    /* unpacks a batch of coalesced messages; the batch is delayed as a whole until all recipients are registered */
+    inline int static_unpack_batch(void *data, std::size_t size, int src_rank) {
+      msg_header_t *msg = static_cast<msg_header_t *>(data);
+      unsigned char *bytes = static_cast<unsigned char *>(data);
+      parsec_taskpool_t *tp = parsec_taskpool_lookup(msg->taskpool_id);
+      assert(NULL != tp);
+      std::vector<static_set_arg_fct_call_t> calls;
+      calls.reserve(msg->num_keys);
+      for (std::size_t k = 0, pos = sizeof(msg_header_t); k < static_cast<std::size_t>(msg->num_keys); ++k) {
+        uint64_t msg_size;
+        std::memcpy(&msg_size, bytes + pos, sizeof(msg_size));
+        auto op_id = reinterpret_cast<msg_header_t *>(bytes + pos + sizeof(msg_size))->op_id;
+        auto &slot = static_id_to_op_map.slot(op_id);
+        if (!slot.registered_or_delay(op_id, data, size, src_rank)) return 1;
+        calls.push_back(slot.call);
+        pos += msg_aggregator::record_size(msg_size);
+      }
+      tp->tdm.module->incoming_message_start(tp, src_rank, NULL, NULL, 0, NULL);
+      std::size_t pos = sizeof(msg_header_t);
+      for (auto &&call : calls) {
+        uint64_t msg_size;
+        std::memcpy(&msg_size, bytes + pos, sizeof(msg_size));
+        call.first(bytes + pos + sizeof(msg_size), msg_size, call.second);
+        pos += msg_aggregator::record_size(msg_size);
+      }
+      assert(pos == size);
+      tp->tdm.module->incoming_message_end(tp, NULL);
+      return 0;
+    }
+
     static int static_unpack_msg(parsec_comm_engine_t *ce, uint64_t tag, void *data, long unsigned int size,
                                  int src_rank, void *obj) {
-      static_set_arg_fct_type static_set_arg_fct;
       parsec_taskpool_t *tp = NULL;
       msg_header_t *msg = static_cast<msg_header_t *>(data);
+      // the communication thread also sends the expired batches of the threads that went idle, see msg_aggregator
+      msg_aggregator::flush_expired();
+      if (msg_header_t::MSG_BATCH == msg->fn_id) {
+        return static_unpack_batch(data, size, src_rank);
+      }
       uint64_t op_id = msg->op_id;
       tp = parsec_taskpool_lookup(msg->taskpool_id);
       assert(NULL != tp);
-      static_map_mutex.lock();
-      try {
-        auto op_pair = static_id_to_op_map.at(op_id);
-        static_map_mutex.unlock();
-        tp->tdm.module->incoming_message_start(tp, src_rank, NULL, NULL, 0, NULL);
-        static_set_arg_fct = op_pair.first;
-        static_set_arg_fct(data, size, op_pair.second);
-        tp->tdm.module->incoming_message_end(tp, NULL);
-        return 0;
-      } catch (const std::out_of_range &e) {
-        void *data_cpy = malloc(size);
-        assert(data_cpy != 0);
-        memcpy(data_cpy, data, size);
-        if (ttg::tracing()) {
-          ttg::print("ttg_parsec(", ttg_default_execution_context().rank(), ") Delaying delivery of message (",
-                     src_rank, ", ", op_id, ", ", data_cpy, ", ", size, ")");
-        }
-        delayed_unpack_actions.insert(std::make_pair(op_id, std::make_tuple(src_rank, data_cpy, size)));
-        static_map_mutex.unlock();
-        return 1;
-      }
+      auto &slot = static_id_to_op_map.slot(op_id);
+      if (!slot.registered_or_delay(op_id, data, size, src_rank)) return 1;
+      tp->tdm.module->incoming_message_start(tp, src_rank, NULL, NULL, 0, NULL);
+      slot.call.first(data, size, slot.call.second);
+      tp->tdm.module->incoming_message_end(tp, NULL);
+      return 0;
     }
 
     static int get_remote_complete_cb(parsec_comm_engine_t *ce, parsec_ce_tag_t tag, void *msg, size_t msg_size,
@@ -204,6 +381,18 @@ namespace ttg_parsec {
       parsec_ce.tag_register(_PARSEC_TTG_TAG, &detail::static_unpack_msg, this, PARSEC_TTG_MAX_AM_SIZE);
       parsec_ce.tag_register(_PARSEC_TTG_RMA_TAG, &detail::get_remote_complete_cb, this, 128);
 
+      // the task class of the task that flushes the expired message batches, see schedule_flusher
+      memset(&m_flusher_class, 0, sizeof(parsec_task_class_t));
+      m_flusher_class.name = "ttg_flush_msg_batches";
+      m_flusher_chores[0].type = PARSEC_DEV_CPU;
+      m_flusher_chores[0].evaluate = NULL;
+      m_flusher_chores[0].hook = &WorldImpl::flusher_hook;
+      m_flusher_chores[1].type = PARSEC_DEV_NONE;
+      m_flusher_chores[1].evaluate = NULL;
+      m_flusher_chores[1].hook = NULL;
+      m_flusher_class.incarnations = m_flusher_chores;
+      m_flusher_class.release_task = &WorldImpl::release_flusher;
+
       create_tpool();
     }
 
@@ -255,6 +444,64 @@ namespace ttg_parsec {
     constexpr int parsec_ttg_tag() const { return _PARSEC_TTG_TAG; }
     constexpr int parsec_ttg_rma_tag() const { return _PARSEC_TTG_RMA_TAG; }
 
+    /// @return the size (in bytes, including the message header) of the largest message that carries a serialized
+    ///         value directly; larger values are exposed in a registered buffer that the receiver pulls
+    std::size_t eager_limit() const { return m_eager_limit; }
+
+    /// sets the eager/rendezvous threshold of remote sends
+    /// \param limit message size in bytes, including the message header; capped at PARSEC_TTG_MAX_AM_SIZE
+    void set_eager_limit(std::size_t limit) {
+      m_eager_limit = std::min(limit, static_cast<std::size_t>(PARSEC_TTG_MAX_AM_SIZE));
+    }
+
+    /// @return true if small remote messages are coalesced per destination rank
+    bool msg_aggregation() const { return m_msg_aggregation; }
+
+    /// controls coalescing of small remote messages per destination rank (disabled by default)
+    /// \param enable if true, messages are buffered per destination and sent in batches
+    /// \param batch_size size of a batch in bytes; a batch is sent when full, messages that do not fit in an empty
+    ///        batch are sent on their own
+    /// \param max_delay a batch is sent once its oldest message is older than this, by the sending thread or by a
+    ///        flush task (see schedule_flusher); in any case batches are sent when the sending thread blocks in a
+    ///        collective or a fence
+    void set_msg_aggregation(bool enable, std::size_t batch_size = 64 * 1024,
+                             std::chrono::microseconds max_delay = std::chrono::microseconds(100)) {
+      m_msg_aggregation = enable;
+      m_msg_batch_size = std::min(batch_size, static_cast<std::size_t>(PARSEC_TTG_MAX_AM_SIZE));
+      m_msg_batch_delay = max_delay;
+    }
+
+    std::size_t msg_batch_size() const { return m_msg_batch_size; }
+    std::chrono::microseconds msg_batch_delay() const { return m_msg_batch_delay; }
+
+    /// sends active message \p msg of \p size bytes to rank \p owner, coalescing it with other messages to the same
+    /// rank if enabled by set_msg_aggregation()
+    void send_msg(int owner, void *msg, std::size_t size) {
+      m_nmsgs_sent.fetch_add(1, std::memory_order_relaxed);
+      if (m_msg_aggregation && detail::msg_aggregator::instance().append(*this, owner, msg, size)) return;
+      send_am(owner, msg, size);
+    }
+
+    /// sends \p msg of \p size bytes to rank \p owner as a single active message, accounted for by the termination
+    /// detection
+    void send_am(int owner, void *msg, std::size_t size) {
+      m_nams_sent.fetch_add(1, std::memory_order_relaxed);
+      tpool->tdm.module->outgoing_message_start(tpool, owner, NULL);
+      tpool->tdm.module->outgoing_message_pack(tpool, owner, NULL, NULL, 0);
+      parsec_ce.send_am(&parsec_ce, _PARSEC_TTG_TAG, owner, msg, size);
+    }
+
+    /// @return the number of messages sent by this rank with send_msg(), and the number of active messages that
+    ///         carried them; the two differ if messages are coalesced (see set_msg_aggregation)
+    std::array<std::uint64_t, 2> msg_stats() const {
+      return {m_nmsgs_sent.load(std::memory_order_relaxed), m_nams_sent.load(std::memory_order_relaxed)};
+    }
+
+    /// schedules the task that sends the expired message batches of all threads, unless it is scheduled already;
+    /// called when a batch becomes nonempty. The task is a low-priority PaRSEC task that reschedules itself while any
+    /// batch is pending, hence it also keeps the taskpool from terminating with messages held back in a batch.
+    void schedule_flusher();
+
     virtual int size() const override {
       int size;
 
@@ -271,14 +518,19 @@ namespace ttg_parsec {
     MPI_Comm comm() const { return MPI_COMM_WORLD; }
 
     virtual void execute() override {
-      parsec_enqueue(ctx, tpool);
-      tpool->tdm.module->taskpool_addto_nb_pa(tpool, 1);
-      tpool->tdm.module->taskpool_ready(tpool);
+      enqueue_tpool();
       int ret = parsec_context_start(ctx);
       parsec_taskpool_started = true;
       if (ret != 0) throw std::runtime_error("TTG: parsec_context_start failed");
     }
 
+    /// adds the taskpool to the context and marks it ready, see create_tpool
+    void enqueue_tpool() {
+      parsec_enqueue(ctx, tpool);
+      tpool->tdm.module->taskpool_addto_nb_pa(tpool, 1);
+      tpool->tdm.module->taskpool_ready(tpool);
+    }
+
     void destroy_tpool() {
       parsec_taskpool_free(tpool);
       tpool = nullptr;
@@ -311,6 +563,20 @@ namespace ttg_parsec {
 
     auto *context() { return ctx; }
     auto *execution_stream() { return parsec_ttg_es == nullptr ? es : parsec_ttg_es; }
+    /// @return the execution stream of worker thread \p thread , counting the threads of all virtual processes
+    ///         (modulo the number of worker threads), or the one of the calling thread if \p thread is negative
+    parsec_execution_stream_t *execution_stream(int thread) {
+      if (thread < 0) return execution_stream();
+      int nthreads = 0;
+      for (int i = 0; i < ctx->nb_vp; i++) nthreads += ctx->virtual_processes[i]->nb_cores;
+      thread %= nthreads;
+      for (int i = 0; i < ctx->nb_vp; i++) {
+        auto *vp = ctx->virtual_processes[i];
+        if (thread < vp->nb_cores) return vp->execution_streams[thread];
+        thread -= vp->nb_cores;
+      }
+      return execution_stream();
+    }
     auto *taskpool() { return tpool; }
 
     void increment_created() { taskpool()->tdm.module->taskpool_addto_nb_tasks(taskpool(), 1); }
@@ -321,6 +587,20 @@ namespace ttg_parsec {
 
     int32_t sent_to_sched() const { return this->sent_to_sched_counter(); }
 
+    /// @return the number of fences completed since the world was started
+    std::uint64_t epoch() const { return m_epoch; }
+
+    virtual std::future<void> fence_async(void) override {
+      // send the messages coalesced by the calling thread, the fence runs on another thread
+      detail::msg_aggregator::instance().flush();
+      return WorldImplBase::fence_async();
+    }
+
+    virtual std::future<void> fence_async(std::vector<ttg::OpBase *> ops) override {
+      detail::msg_aggregator::instance().flush();
+      return WorldImplBase::fence_async(std::move(ops));
+    }
+
     virtual void final_task() override {
 #ifdef TTG_USE_USER_TERMDET
       taskpool()->tdm.module->taskpool_set_nb_tasks(taskpool(), 0);
@@ -330,6 +610,8 @@ namespace ttg_parsec {
    protected:
     virtual void fence_impl(void) override {
       int rank = this->rank();
+      // send the messages coalesced by the main thread
+      detail::msg_aggregator::instance().flush();
       if (!parsec_taskpool_started) {
         if (ttg::tracing()) {
           ttg::print("ttg_parsec::(", rank, "): parsec taskpool has not been started, fence is a simple MPI_Barrier");
@@ -343,18 +625,27 @@ namespace ttg_parsec {
       // We are locally ready (i.e. we won't add new tasks)
       tpool->tdm.module->taskpool_addto_nb_pa(tpool, -1);
       if (ttg::tracing()) {
-        ttg::print("ttg_parsec(", rank, "): waiting for completion");
+        ttg::print("ttg_parsec(", rank, "): waiting for completion of epoch ", m_epoch);
       }
-      parsec_context_wait(ctx);
+      // the worker threads keep running, only the tasks of this taskpool are waited for
+      parsec_taskpool_wait(tpool);
 
-      // We need the synchronization between the end of the context and the restart of the taskpool
-      // until we use parsec_taskpool_wait and implement an epoch in the PaRSEC taskpool
-      // see Issue #118 (TTG)
-      MPI_Barrier(comm());
+      ++m_epoch;
 
+      // termination of a taskpool is final, the next epoch runs in a new taskpool, see Issue #118 (TTG).
+      // No rank may destroy its taskpool while termination detection messages to it are in flight ...
+      MPI_Barrier(comm());
       destroy_tpool();
+      // ... and create_tpool synchronizes the ranks again before any of them sends messages of the new epoch
       create_tpool();
-      execute();
+      enqueue_tpool();
+      parsec_taskpool_started = true;
+    }
+
+    virtual void allreduce_sum(std::uint64_t *values, std::size_t n) override {
+      // the messages coalesced by the calling thread are accounted for as sent
+      detail::msg_aggregator::instance().flush();
+      MPI_Allreduce(MPI_IN_PLACE, values, n, MPI_UINT64_T, MPI_SUM, comm());
     }
 
    private:
@@ -362,6 +653,22 @@ namespace ttg_parsec {
     parsec_execution_stream_t *es = nullptr;
     parsec_taskpool_t *tpool = nullptr;
     bool parsec_taskpool_started = false;
+    std::uint64_t m_epoch = 0;
+    std::size_t m_eager_limit = PARSEC_TTG_MAX_AM_SIZE;
+    bool m_msg_aggregation = false;
+    std::size_t m_msg_batch_size = 64 * 1024;
+    std::chrono::microseconds m_msg_batch_delay = std::chrono::microseconds(100);
+    std::atomic<std::uint64_t> m_nmsgs_sent = 0;  // see msg_stats
+    std::atomic<std::uint64_t> m_nams_sent = 0;
+    parsec_task_class_t m_flusher_class;  // see schedule_flusher
+    __parsec_chore_t m_flusher_chores[2];
+    std::atomic<bool> m_flusher_scheduled = false;
+
+    /// body of the flush task, see schedule_flusher
+    static parsec_hook_return_t flusher_hook(parsec_execution_stream_t *es, parsec_task_t *task);
+
+    /// releases the flush task, see schedule_flusher
+    static parsec_hook_return_t release_flusher(parsec_execution_stream_t *es, parsec_task_t *task);
 
     volatile int32_t &sent_to_sched_counter() const {
       static volatile int32_t sent_to_sched = 0;
@@ -370,8 +677,198 @@ namespace ttg_parsec {
   };
 
   namespace detail {
+    inline bool msg_aggregator::append(WorldImpl &world, int owner, const void *msg, std::size_t size) {
+      std::scoped_lock lock(mtx);
+      if (this->world != &world) {
+        flush_unlocked();
+        this->world = &world;
+        batches.clear();
+      }
+      if (batches.empty()) batches.resize(world.size());
+      auto &batch = batches[owner];
+      const std::size_t rsize = record_size(size);
+      if (sizeof(msg_header_t) + rsize > world.msg_batch_size()) {
+        flush_unlocked(owner);
+        return false;
+      }
+      if (batch.size > 0 && (batch.size + rsize > batch.capacity ||
+                             std::chrono::steady_clock::now() - batch.first_msg_time > world.msg_batch_delay())) {
+        flush_unlocked(owner);
+      }
+      if (0 == batch.size) {
+        if (batch.capacity < world.msg_batch_size()) {
+          batch.capacity = world.msg_batch_size();
+          batch.buffer = std::make_unique<unsigned char[]>(batch.capacity);
+        }
+        new (batch.buffer.get()) msg_header_t{world.taskpool()->taskpool_id, 0, msg_header_t::MSG_BATCH, -1, 0};
+        batch.size = sizeof(msg_header_t);
+        batch.first_msg_time = std::chrono::steady_clock::now();
+        ++num_nonempty;
+        ++registry().num_nonempty;
+        world.schedule_flusher();
+      }
+      uint64_t msg_size = size;
+      std::memcpy(batch.buffer.get() + batch.size, &msg_size, sizeof(msg_size));
+      std::memcpy(batch.buffer.get() + batch.size + sizeof(msg_size), msg, size);
+      batch.size += rsize;
+      reinterpret_cast<msg_header_t *>(batch.buffer.get())->num_keys++;
+      return true;
+    }
+
+    inline void msg_aggregator::flush_unlocked(int owner) {
+      if (batches.empty() || 0 == batches[owner].size) return;
+      auto &batch = batches[owner];
+      /* termination detection accounts for the batch as a single message */
+      world->send_am(owner, batch.buffer.get(), batch.size);
+      batch.size = 0;
+      --num_nonempty;
+      --registry().num_nonempty;
+    }
+
+    inline void msg_aggregator::flush_expired() {
+      auto &r = registry();
+      if (0 == r.num_nonempty.load(std::memory_order_relaxed)) return;
+      std::unique_lock lock(r.mtx, std::try_to_lock);
+      if (!lock) return;
+      const auto now = std::chrono::steady_clock::now();
+      for (auto *aggregator : r.aggregators) {
+        std::unique_lock aggregator_lock(aggregator->mtx, std::try_to_lock);
+        if (!aggregator_lock || 0 == aggregator->num_nonempty) continue;
+        for (int owner = 0; owner < static_cast<int>(aggregator->batches.size()); ++owner) {
+          const auto &batch = aggregator->batches[owner];
+          if (batch.size > 0 && now - batch.first_msg_time > aggregator->world->msg_batch_delay())
+            aggregator->flush_unlocked(owner);
+        }
+      }
+    }
+
     typedef void (*parsec_static_op_t)(void *);  // static_op will be cast to this type
 
+    /// Values of a stream waiting to be reduced by a reduction task
+
+    /// Senders push values and return, a single reduction task at a time pops and reduces them. The sender that
+    /// makes the queue nonempty is responsible for submitting the reduction task, which keeps draining the queue
+    /// until no values are pending.
+    template <typename T>
+    class reduction_queue {
+     public:
+      struct node {
+        node *next;
+        std::optional<T> value;  // empty = end of stream, see Op::finalize_argstream
+      };
+
+      /// pushes \p n ; the queue must not be accessed after this returns, since the reduction task may complete and
+      /// destroy it as soon as \p n is processed
+      /// @return true if the queue was empty, i.e. the caller must submit a reduction task
+      bool push(node *n) {
+        // N.B. count n as pending before publishing it, so that the reduction task cannot see the queue idle while n
+        // is being pushed
+        const bool first = pending_.fetch_add(1, std::memory_order_acq_rel) == 0;
+        node *head = head_.load(std::memory_order_relaxed);
+        do {
+          n->next = head;
+        } while (!head_.compare_exchange_weak(head, n, std::memory_order_release, std::memory_order_relaxed));
+        return first;
+      }
+
+      /// @return the list of queued nodes, in the order they were pushed
+      node *pop_all() {
+        node *head = head_.exchange(nullptr, std::memory_order_acquire);
+        node *reversed = nullptr;
+        while (head != nullptr) {
+          node *next = head->next;
+          head->next = reversed;
+          reversed = head;
+          head = next;
+        }
+        return reversed;
+      }
+
+      /// called by the reduction task after processing \p n nodes
+      /// @return true if no nodes are pending, i.e. the reduction task can complete; the queue may be destroyed only
+      ///         then
+      bool processed(std::size_t n) { return pending_.fetch_sub(n, std::memory_order_acq_rel) == n; }
+
+     private:
+      std::atomic<node *> head_ = nullptr;
+      std::atomic<std::size_t> pending_ = 0;  // # of pushed nodes not yet processed
+    };
+
+    /// true if the object representation of Key has no padding bits
+    template <typename Key, typename Enabler = void>
+    struct has_no_padding : std::bool_constant<std::has_unique_object_representations_v<Key>> {};
+    template <typename T1, typename T2>
+    struct has_no_padding<std::pair<T1, T2>>
+        : std::bool_constant<has_no_padding<T1>::value && has_no_padding<T2>::value &&
+                             sizeof(std::pair<T1, T2>) == sizeof(T1) + sizeof(T2)> {};
+    template <typename... Ts>
+    struct has_no_padding<std::tuple<Ts...>>
+        : std::bool_constant<(has_no_padding<Ts>::value && ...) &&
+                             sizeof(std::tuple<Ts...>) == (sizeof(Ts) + ... + 0)> {};
+
+    /// keys that are trivially copyable, fit into parsec_key_t and have no padding are encoded in parsec_key_t
+    /// directly, hence hashed and compared as integers
+    /// \note assumes that operator== of such keys compares all bits of the object representation
+    template <typename Key>
+    constexpr bool is_packable_key_v = std::is_trivially_copy_constructible_v<Key> &&
+                                       std::is_trivially_destructible_v<Key> &&
+                                       sizeof(Key) <= sizeof(parsec_key_t) && has_no_padding<Key>::value;
+    template <>
+    constexpr bool is_packable_key_v<void> = false;
+
+    /// Provides the parsec_key_t of a key of type Key, and the functions that the tasks tables use on it.
+    /// A packable key (see is_packable_key_v) is stored in its parsec_key_t, any other key is referred to by a
+    /// parsec_key_t that points to this object, which caches the hash of the key and hence must outlive the
+    /// parsec_key_t.
+    template <typename Key, bool Packable = is_packable_key_v<Key>>
+    class hashed_key_t {
+      const Key *key_;
+      uint64_t hash_;
+
+     public:
+      explicit hashed_key_t(const Key &key) : key_(&key), hash_(ttg::hash<Key>{}(key)) {}
+      hashed_key_t(const hashed_key_t &) = delete;
+      hashed_key_t &operator=(const hashed_key_t &) = delete;
+
+      parsec_key_t pkey() const { return reinterpret_cast<parsec_key_t>(this); }
+
+      static int equal(parsec_key_t a, parsec_key_t b) {
+        auto *ha = reinterpret_cast<const hashed_key_t *>(a);
+        auto *hb = reinterpret_cast<const hashed_key_t *>(b);
+        return ha->hash_ == hb->hash_ && *ha->key_ == *hb->key_;
+      }
+      static uint64_t hash(parsec_key_t k) { return reinterpret_cast<const hashed_key_t *>(k)->hash_; }
+      static const Key &key(parsec_key_t k) { return *reinterpret_cast<const hashed_key_t *>(k)->key_; }
+    };
+
+    template <typename Key>
+    class hashed_key_t<Key, true> {
+      parsec_key_t pkey_ = 0;
+
+     public:
+      explicit hashed_key_t(const Key &key) { std::memcpy(&pkey_, static_cast<const void *>(&key), sizeof(Key)); }
+
+      parsec_key_t pkey() const { return pkey_; }
+
+      static int equal(parsec_key_t a, parsec_key_t b) { return a == b; }
+      static uint64_t hash(parsec_key_t k) { return ttg::detail::WordHasher::mix(k); }
+      static Key key(parsec_key_t k) {
+        Key key;
+        std::memcpy(static_cast<void *>(&key), &k, sizeof(Key));
+        return key;
+      }
+    };
+
+    /// void keys all map to the same parsec_key_t
+    template <bool Packable>
+    class hashed_key_t<void, Packable> {
+     public:
+      template <typename Key>
+      explicit hashed_key_t(const Key &) {}
+
+      parsec_key_t pkey() const { return 0; }
+    };
+
     struct parsec_ttg_task_base_t {
       parsec_task_t parsec_task = {};
       int32_t in_data_count = 0;
@@ -383,6 +880,7 @@ namespace ttg_parsec {
       void (*deferred_release)(void *, parsec_ttg_task_base_t *) =
           nullptr;  // callback used to release the task from with the static context of complete_task_and_release
       void *op_ptr = nullptr;  // passed to deferred_release
+      parsec_ttg_task_base_t *reduced_task = nullptr;  // for reduction tasks: the task whose stream is reduced
 
       parsec_ttg_task_base_t(parsec_thread_mempool_t *mempool, parsec_task_class_t *task_class) {
         PARSEC_OBJ_CONSTRUCT(&this->parsec_task, parsec_task_t);
@@ -408,11 +906,14 @@ namespace ttg_parsec {
     struct parsec_ttg_task_t : public parsec_ttg_task_base_t {
 
       Key key;
+      hashed_key_t<Key> hkey{key};  // N.B. refers to key, must follow it
       typedef struct {
         std::size_t goal;
         std::size_t size;
       } size_goal_t;
       size_goal_t stream[NumStreams] = {};
+      void *partials[NumStreams] = {};  // partial results of commutative streams, see ttg::detail::partial_reduction
+      void *queues[NumStreams] = {};    // values of asynchronously reduced streams, see detail::reduction_queue
 
       parsec_ttg_task_t(parsec_thread_mempool_t *mempool, parsec_task_class_t *task_class)
       : parsec_ttg_task_base_t(mempool, task_class)
@@ -427,7 +928,7 @@ namespace ttg_parsec {
         op_ht_item.key = pkey();
       }
 
-      parsec_key_t pkey() { return reinterpret_cast<parsec_key_t>(&key); }
+      parsec_key_t pkey() { return hkey.pkey(); }
     };
 
 
@@ -439,6 +940,8 @@ namespace ttg_parsec {
         std::size_t size;
       } size_goal_t;
       size_goal_t stream[NumStreams] = {};
+      void *partials[NumStreams] = {};  // partial results of commutative streams, see ttg::detail::partial_reduction
+      void *queues[NumStreams] = {};    // values of asynchronously reduced streams, see detail::reduction_queue
 
       parsec_ttg_task_t(parsec_thread_mempool_t *mempool, parsec_task_class_t *task_class)
       : parsec_ttg_task_base_t(mempool, task_class)
@@ -528,6 +1031,23 @@ namespace ttg_parsec {
       ValueT &value() { return _value; }
     };
 
+    template <typename ActivationCallbackT>
+    class rma_rendezvous_activate {
+      std::unique_ptr<unsigned char[]> _buffer;
+      ActivationCallbackT _cb;
+
+     public:
+      rma_rendezvous_activate(std::size_t size, ActivationCallbackT cb)
+          : _buffer(std::make_unique<unsigned char[]>(size)), _cb(std::move(cb)) {}
+
+      bool complete_transfer(void) {
+        _cb(_buffer.get());
+        return true;
+      }
+
+      unsigned char *buffer() { return _buffer.get(); }
+    };
+
     template <typename ActivationT>
     static int get_complete_cb(parsec_comm_engine_t *comm_engine, parsec_ce_mem_reg_handle_t lreg, ptrdiff_t ldispl,
                                parsec_ce_mem_reg_handle_t rreg, ptrdiff_t rdispl, size_t size, int remote,
@@ -656,6 +1176,34 @@ namespace ttg_parsec {
     }
   }  // namespace detail
 
+  inline void WorldImpl::schedule_flusher() {
+    if (m_flusher_scheduled.exchange(true)) return;
+    auto *task = new detail::parsec_ttg_task_base_t(nullptr, &m_flusher_class, tpool, this,
+                                                    std::numeric_limits<int32_t>::min());
+    increment_created();
+    increment_sent_to_sched();
+    __parsec_schedule(execution_stream(), &task->parsec_task, 0);
+  }
+
+  inline parsec_hook_return_t WorldImpl::flusher_hook(parsec_execution_stream_t *es, parsec_task_t *task) {
+    auto *world = static_cast<WorldImpl *>(reinterpret_cast<detail::parsec_ttg_task_base_t *>(task)->object_ptr);
+    detail::msg_aggregator::flush_expired();
+    // N.B. a thread that makes a batch nonempty after the check below sees the flag cleared and schedules a new task
+    world->m_flusher_scheduled.store(false);
+    if (detail::msg_aggregator::num_pending() > 0 && !world->m_flusher_scheduled.exchange(true))
+      return PARSEC_HOOK_RETURN_AGAIN;  // PaRSEC reschedules the task
+    return PARSEC_HOOK_RETURN_DONE;
+  }
+
+  inline parsec_hook_return_t WorldImpl::release_flusher(parsec_execution_stream_t *es, parsec_task_t *task) {
+    parsec_taskpool_t *tp = task->taskpool;
+    auto *flusher = reinterpret_cast<detail::parsec_ttg_task_base_t *>(task);
+    PARSEC_OBJ_DESTRUCT(&flusher->parsec_task);
+    delete flusher;
+    tp->tdm.module->taskpool_addto_nb_tasks(tp, -1);
+    return PARSEC_HOOK_RETURN_DONE;
+  }
+
   template <typename... RestOfArgs>
   inline void ttg_initialize(int argc, char **argv, int taskpool_size, RestOfArgs &&...) {
     int provided;
@@ -676,6 +1224,14 @@ namespace ttg_parsec {
   inline void ttg_execute(ttg::World world) { world.impl().execute(); }
   inline void ttg_fence(ttg::World world) { world.impl().fence(); }
 
+  inline std::future<void> ttg_fence_async(ttg::World world) { return world.impl().fence_async(); }
+
+  inline void ttg_fence(ttg::World world, const std::vector<ttg::OpBase *> &ops) { world.impl().fence(ops); }
+
+  inline std::future<void> ttg_fence_async(ttg::World world, std::vector<ttg::OpBase *> ops) {
+    return world.impl().fence_async(std::move(ops));
+  }
+
   template <typename T>
   inline void ttg_register_ptr(ttg::World world, const std::shared_ptr<T> &ptr) {
     world.impl().register_ptr(ptr);
@@ -692,31 +1248,187 @@ namespace ttg_parsec {
 
   inline ttg::Edge<> &ttg_ctl_edge(ttg::World world) { return world.impl().ctl_edge(); }
 
-  inline void ttg_sum(ttg::World world, double &value) {
-    double result = 0.0;
-    MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_SUM, world.impl().comm());
-    value = result;
+  namespace detail {
+
+    /// whether \c T is one of the types that mpi_datatype maps to a builtin MPI datatype
+    template <typename T>
+    inline constexpr bool is_mpi_builtin_v =
+        std::is_same_v<T, bool> || std::is_same_v<T, char> || std::is_same_v<T, signed char> ||
+        std::is_same_v<T, unsigned char> || std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
+        std::is_same_v<T, int> || std::is_same_v<T, unsigned int> || std::is_same_v<T, long> ||
+        std::is_same_v<T, unsigned long> || std::is_same_v<T, long long> || std::is_same_v<T, unsigned long long> ||
+        std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, long double>;
+
+    /// @return the MPI datatype of \c T ; types other than those in is_mpi_builtin_v are transferred as bytes
+    template <typename T>
+    MPI_Datatype mpi_datatype() {
+      static_assert(std::is_trivially_copyable_v<T>);
+      if constexpr (std::is_same_v<T, bool>)
+        return MPI_CXX_BOOL;
+      else if constexpr (std::is_same_v<T, char>)  // N.B. MPI_CHAR does not support arithmetic reductions
+        return std::is_signed_v<char> ? MPI_SIGNED_CHAR : MPI_UNSIGNED_CHAR;
+      else if constexpr (std::is_same_v<T, signed char>)
+        return MPI_SIGNED_CHAR;
+      else if constexpr (std::is_same_v<T, unsigned char>)
+        return MPI_UNSIGNED_CHAR;
+      else if constexpr (std::is_same_v<T, short>)
+        return MPI_SHORT;
+      else if constexpr (std::is_same_v<T, unsigned short>)
+        return MPI_UNSIGNED_SHORT;
+      else if constexpr (std::is_same_v<T, float>)
+        return MPI_FLOAT;
+      else if constexpr (std::is_same_v<T, double>)
+        return MPI_DOUBLE;
+      else if constexpr (std::is_same_v<T, long double>)
+        return MPI_LONG_DOUBLE;
+      else if constexpr (std::is_same_v<T, int>)
+        return MPI_INT;
+      else if constexpr (std::is_same_v<T, long>)
+        return MPI_LONG;
+      else if constexpr (std::is_same_v<T, long long>)
+        return MPI_LONG_LONG;
+      else if constexpr (std::is_same_v<T, unsigned int>)
+        return MPI_UNSIGNED;
+      else if constexpr (std::is_same_v<T, unsigned long>)
+        return MPI_UNSIGNED_LONG;
+      else if constexpr (std::is_same_v<T, unsigned long long>)
+        return MPI_UNSIGNED_LONG_LONG;
+      else {
+        static const MPI_Datatype type = [] {
+          MPI_Datatype type;
+          MPI_Type_contiguous(sizeof(T), MPI_BYTE, &type);
+          MPI_Type_commit(&type);
+          return type;
+        }();
+        return type;
+      }
+    }
+
+    /// @return the MPI reduction operation that applies \c Op to values of type \c T
+    template <typename T, typename Op>
+    MPI_Op mpi_op() {
+      // MPI_SUM and MPI_PROD apply only to builtin numeric datatypes, i.e. not to bool or to types sent as bytes
+      constexpr bool builtin = is_mpi_builtin_v<T> && !std::is_same_v<T, bool>;
+      if constexpr (builtin && (std::is_same_v<Op, std::plus<T>> || std::is_same_v<Op, std::plus<>>)) {
+        return MPI_SUM;
+      } else if constexpr (builtin && (std::is_same_v<Op, std::multiplies<T>> || std::is_same_v<Op, std::multiplies<>>)) {
+        return MPI_PROD;
+      } else {
+        static_assert(std::is_default_constructible_v<Op>, "ttg_allreduce: the reduction operation must be stateless");
+        static const MPI_Op op = [] {
+          MPI_Op op;
+          MPI_Op_create(
+              [](void *in, void *inout, int *len, MPI_Datatype *) {
+                auto *a = static_cast<const T *>(in);
+                auto *b = static_cast<T *>(inout);
+                for (int k = 0; k != *len; ++k) b[k] = Op{}(a[k], b[k]);
+              },
+              /* commute = */ 1, &op);
+          return op;
+        }();
+        return op;
+      }
+    }
+
+  }  // namespace detail
+
+  /// all-reduce
+  /// starts the reduction of \p value over all ranks of \p world with \c Op and returns without waiting for it
+  /// @tparam T a trivially-copyable type
+  /// @tparam Op a stateless, associative and commutative binary operation on \c T
+  /// @return the future result, collected when it is first waited on
+  /// \note like any collective, must be called by all ranks in the same order
+  template <typename T, typename Op>
+  std::future<T> ttg_allreduce(ttg::World world, const T &value, Op) {
+    static_assert(std::is_trivially_copyable_v<T>, "ttg_allreduce: T must be trivially copyable");
+    struct state_t {
+      T value;
+      T result;
+      MPI_Request request;
+    };
+    auto state = std::make_shared<state_t>(state_t{value, value, MPI_REQUEST_NULL});
+    MPI_Iallreduce(&state->value, &state->result, 1, detail::mpi_datatype<T>(), detail::mpi_op<T, Op>(),
+                   world.impl().comm(), &state->request);
+    return std::async(std::launch::deferred, [state] {
+      // the waiting thread sends nothing until the reduction completes, do not hold back its batches
+      detail::msg_aggregator::instance().flush();
+      MPI_Wait(&state->request, MPI_STATUS_IGNORE);
+      return state->result;
+    });
+  }
+
+  template <typename T>
+  inline void ttg_sum(ttg::World world, T &value) {
+    value = ttg_allreduce(world, value).get();
   }
 
   /// broadcast
+  /// starts broadcasting \p data from \p source_rank to all ranks of \p world and returns without waiting for it.
+  /// Trivially-copyable types and types with split metadata are received directly into the result; the metadata of
+  /// the latter, and the size of other serializable types, are broadcast before returning.
   /// @tparam T a serializable type
+  /// @return the future broadcast value, collected when it is first waited on
+  /// \note like any collective, must be called by all ranks in the same order
   template <typename T>
-  void ttg_broadcast(::ttg::World world, T &data, int source_rank) {
-    int64_t BUFLEN;
-    if (world.rank() == source_rank) {
-      BUFLEN = ttg::default_data_descriptor<T>::payload_size(&data);
+  std::future<T> ttg_broadcast_async(ttg::World world, T data, int source_rank) {
+    // the metadata is broadcast before returning
+    detail::msg_aggregator::instance().flush();
+    auto comm = world.impl().comm();
+    const bool is_source = world.rank() == source_rank;
+    if constexpr (ttg::has_split_metadata<T>::value) {
+      ttg::SplitMetadataDescriptor<T> descr;
+      auto metadata = descr.get_metadata(data);
+      MPI_Bcast(&metadata, sizeof(metadata), MPI_BYTE, source_rank, comm);
+      auto result = std::make_shared<T>(is_source ? std::move(data) : descr.create_from_metadata(metadata));
+      auto requests = std::make_shared<std::vector<MPI_Request>>();
+      for (auto &&iov : descr.get_data(*result)) {
+        requests->emplace_back();
+        MPI_Ibcast(iov.data, iov.num_bytes, MPI_BYTE, source_rank, comm, &requests->back());
+      }
+      return std::async(std::launch::deferred, [result, requests] {
+        detail::msg_aggregator::instance().flush();  // see ttg_allreduce
+        MPI_Waitall(requests->size(), requests->data(), MPI_STATUSES_IGNORE);
+        return std::move(*result);
+      });
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+      struct state_t {
+        T value;
+        MPI_Request request;
+      };
+      auto state = std::make_shared<state_t>(state_t{std::move(data), MPI_REQUEST_NULL});
+      MPI_Ibcast(&state->value, sizeof(T), MPI_BYTE, source_rank, comm, &state->request);
+      return std::async(std::launch::deferred, [state] {
+        detail::msg_aggregator::instance().flush();
+        MPI_Wait(&state->request, MPI_STATUS_IGNORE);
+        return std::move(state->value);
+      });
+    } else {
+      struct state_t {
+        T value;
+        int64_t size;
+        std::unique_ptr<unsigned char[]> buffer;
+        MPI_Request request;
+      };
+      auto state = std::make_shared<state_t>(state_t{std::move(data), 0, nullptr, MPI_REQUEST_NULL});
+      if (is_source) state->size = ttg::default_data_descriptor<T>::payload_size(&state->value);
+      MPI_Bcast(&state->size, 1, MPI_INT64_T, source_rank, comm);
+      state->buffer = std::make_unique<unsigned char[]>(state->size);
+      if (is_source) ttg::default_data_descriptor<T>::pack_payload(&state->value, state->size, 0, state->buffer.get());
+      MPI_Ibcast(state->buffer.get(), state->size, MPI_UNSIGNED_CHAR, source_rank, comm, &state->request);
+      return std::async(std::launch::deferred, [state, is_source] {
+        detail::msg_aggregator::instance().flush();
+        MPI_Wait(&state->request, MPI_STATUS_IGNORE);
+        if (!is_source) ttg::default_data_descriptor<T>::unpack_payload(&state->value, state->size, 0, state->buffer.get());
+        return std::move(state->value);
+      });
     }
-    MPI_Bcast(&BUFLEN, 1, MPI_INT64_T, source_rank, world.impl().comm());
+  }
 
-    unsigned char *buf = new unsigned char[BUFLEN];
-    if (world.rank() == source_rank) {
-      ttg::default_data_descriptor<T>::pack_payload(&data, BUFLEN, 0, buf);
-    }
-    MPI_Bcast(buf, BUFLEN, MPI_UNSIGNED_CHAR, source_rank, world.impl().comm());
-    if (world.rank() != source_rank) {
-      ttg::default_data_descriptor<T>::unpack_payload(&data, BUFLEN, 0, buf);
-    }
-    delete[] buf;
+  /// broadcast
+  /// @tparam T a serializable type
+  template <typename T>
+  void ttg_broadcast(::ttg::World world, T &data, int source_rank) {
+    data = ttg_broadcast_async(world, std::move(data), source_rank).get();
   }
 
   namespace detail {
@@ -728,13 +1440,144 @@ namespace ttg_parsec {
       parsec_task_class_t self;
     };
 
+    /// the layout of an active message of the largest size; messages are sent with as many bytes of payload as
+    /// they use, hence only the received bytes of a msg_t are addressable
     struct msg_t {
       msg_header_t op_id;
       unsigned char bytes[WorldImpl::PARSEC_TTG_MAX_AM_SIZE - sizeof(msg_header_t)];
+    };
+
+    /// Per-thread pool of active message buffers.
 
-      msg_t() = default;
-      msg_t(uint64_t op_id, uint32_t taskpool_id, msg_header_t::fn_id_t fn_id, int32_t param_id, int num_keys = 1)
-          : op_id{taskpool_id, op_id, fn_id, param_id, num_keys} {}
+    /// A pooled message is a msg_header_t followed by its raw payload, laid out as in msg_t; only the header is an
+    /// object, the payload is accessed as bytes (see msg_ptr::bytes). Buffers come in a few size classes and the
+    /// smallest class that fits the header and the packed payload is used. Buffers are returned to the pool of the
+    /// releasing thread; each thread caches at most \c max_cached[c] buffers of class \c c.
+    class msg_pool {
+     public:
+      static constexpr std::size_t num_size_classes = 4;
+      static constexpr std::array<std::size_t, num_size_classes> size_classes = {
+          256, 4 * 1024, 64 * 1024, WorldImpl::PARSEC_TTG_MAX_AM_SIZE};
+      static constexpr std::array<std::size_t, num_size_classes> max_cached = {256, 64, 16, 2};
+      static_assert(sizeof(msg_header_t) <= size_classes[0]);
+
+      struct deleter {
+        std::size_t size_class;
+        void operator()(msg_header_t *msg) const { msg_pool::release(msg, size_class); }
+      };
+
+      /// owns a pooled message
+      class msg_ptr {
+       public:
+        msg_ptr(msg_header_t *msg, std::size_t size_class) : msg(msg, deleter{size_class}) {}
+
+        /// @return the message, i.e. its header, to be passed to WorldImpl::send_msg
+        msg_header_t *get() const { return msg.get(); }
+        msg_header_t *operator->() const { return msg.get(); }
+        /// @return the payload, which follows the header (at the offset of msg_t::bytes)
+        std::byte *bytes() const { return reinterpret_cast<std::byte *>(msg.get()) + offsetof(msg_t, bytes); }
+
+       private:
+        std::unique_ptr<msg_header_t, deleter> msg;
+      };
+
+      /// @return the smallest size class that holds a message with \p payload_size bytes after the header
+      static constexpr std::size_t size_class(std::size_t payload_size) {
+        const std::size_t msg_size = offsetof(msg_t, bytes) + payload_size;
+        std::size_t c = 0;
+        while (c < num_size_classes - 1 && msg_size > size_classes[c]) ++c;
+        return c;
+      }
+
+      /// @param payload_size the number of bytes that will be packed into msg_ptr::bytes()
+      /// @param args the arguments forwarded to the msg_header_t constructor
+      /// @return a message buffer with room for at least \p payload_size bytes of payload
+      template <typename... Args>
+      static msg_ptr allocate(std::size_t payload_size, Args &&...args) {
+        assert(offsetof(msg_t, bytes) + payload_size <= WorldImpl::PARSEC_TTG_MAX_AM_SIZE);
+        const std::size_t c = size_class(payload_size);
+        auto &freelist = freelists().lists[c];
+        void *buf;
+        if (freelist.empty()) {
+          buf = ::operator new(size_classes[c]);
+        } else {
+          buf = freelist.back();
+          freelist.pop_back();
+        }
+        return msg_ptr(new (buf) msg_header_t(make_header(std::forward<Args>(args)...)), c);
+      }
+
+     private:
+      struct freelists_t {
+        std::array<std::vector<void *>, num_size_classes> lists;
+        ~freelists_t() {
+          for (auto &list : lists)
+            for (auto buf : list) ::operator delete(buf);
+        }
+      };
+
+      static freelists_t &freelists() {
+        static thread_local freelists_t fl;
+        return fl;
+      }
+
+      /// @return the header of a message of op \p op_id
+      static msg_header_t make_header(uint64_t op_id, uint32_t taskpool_id, msg_header_t::fn_id_t fn_id,
+                                      int32_t param_id, int num_keys = 1) {
+        return msg_header_t{taskpool_id, op_id, fn_id, param_id, num_keys};
+      }
+
+      static void release(msg_header_t *msg, std::size_t c) {
+        static_assert(std::is_trivially_destructible_v<msg_header_t>);
+        auto &freelist = freelists().lists[c];
+        if (freelist.size() < max_cached[c])
+          freelist.push_back(msg);
+        else
+          ::operator delete(msg);
+      }
+    };
+
+    /// A serialized value exposed for the receiver to pull with parsec_ce.get (rendezvous protocol)
+    struct rendezvous_buffer_t {
+      std::shared_ptr<unsigned char[]> buffer;
+      std::shared_ptr<void> lreg;  // the registration is dropped along with the last reference
+      int32_t lreg_size = 0;
+      uint64_t size = 0;
+
+      /// @return the number of bytes pack() will write
+      std::size_t packed_size() const {
+        return sizeof(size) + sizeof(int) + sizeof(parsec_ce_tag_t) + sizeof(lreg_size) + lreg_size +
+               sizeof(std::intptr_t);
+      }
+
+      /// packs the descriptor of the buffer for one receiver; the buffer is kept alive until that receiver
+      /// has completed its transfer
+      /// memory layout: [size, rank, cbtag, lreg_size, lreg, release_cb_ptr]
+      uint64_t pack(int rank, void *bytes, uint64_t pos) const {
+        unsigned char *buf = static_cast<unsigned char *>(bytes);
+        std::memcpy(buf + pos, &size, sizeof(size));
+        pos += sizeof(size);
+        std::memcpy(buf + pos, &rank, sizeof(rank));
+        pos += sizeof(rank);
+        /* TODO: at the moment, the tag argument to parsec_ce.get() is treated as a
+         * raw function pointer instead of a preregistered AM tag, so play that game.
+         * Once this is fixed in PaRSEC we need to use parsec_ttg_rma_tag instead! */
+        parsec_ce_tag_t cbtag = reinterpret_cast<parsec_ce_tag_t>(&detail::get_remote_complete_cb);
+        std::memcpy(buf + pos, &cbtag, sizeof(cbtag));
+        pos += sizeof(cbtag);
+        std::memcpy(buf + pos, &lreg_size, sizeof(lreg_size));
+        pos += sizeof(lreg_size);
+        std::memcpy(buf + pos, lreg.get(), lreg_size);
+        pos += lreg_size;
+        std::function<void(void)> *fn = new std::function<void(void)>([buffer = buffer, lreg = lreg]() mutable {
+          lreg.reset();
+          buffer.reset();
+        });
+        std::intptr_t fn_ptr{reinterpret_cast<std::intptr_t>(fn)};
+        std::memcpy(buf + pos, &fn_ptr, sizeof(fn_ptr));
+        pos += sizeof(fn_ptr);
+        return pos;
+      }
     };
   }  // namespace detail
 
@@ -831,15 +1674,20 @@ namespace ttg_parsec {
         make_finalize_argstream_fcts(std::make_index_sequence<numins>{});
 
     ttg::World world;
-    ttg::meta::detail::keymap_t<keyT> keymap;
-    ttg::meta::detail::keymap_t<keyT> priomap;
+    ttg::detail::keymap_type_t<keyT> keymap;
+    ttg::detail::priomap_type_t<keyT> priomap;
+    ttg::meta::detail::keymap_t<keyT> threadmap;  //!< Maps keys to worker threads (empty = no preference)
     // For now use same type for unary/streaming input terminals, and stream reducers assigned at runtime
     ttg::meta::detail::input_reducers_t<input_valueTs...>
         input_reducers;  //!< Reducers for the input terminals (empty = expect single value)
+    std::array<bool, numins>
+        commutative_reducers = {};  //!< Whether streaming inputs are reduced into per-thread partial results
+    std::array<bool, numins> async_reducers = {};  //!< Whether streaming inputs are reduced by reduction tasks
     std::size_t static_stream_goal[numins];
+    std::size_t num_partials = 1;  //!< # of partial results of a commutative stream, one per thread that may contribute
 
    public:
-    ttg::World get_world() const { return world; }
+    ttg::World get_world() const override { return world; }
 
    private:
     /// dispatches a call to derivedT::op if Space == Host, otherwise to derivedT::op_cuda if Space == CUDA
@@ -943,6 +1791,82 @@ namespace ttg_parsec {
       return pos + payload_size;
     }
 
+    /// @return the number of bytes pack() will write for \p obj
+    template <typename T>
+    uint64_t packed_size(const T &obj) {
+      const ttg_data_descriptor *dObj = ttg::get_data_descriptor<ttg::meta::remove_cvr_t<T>>();
+      uint64_t payload_size = dObj->payload_size(&obj);
+      if constexpr (!ttg::default_data_descriptor<ttg::meta::remove_cvr_t<T>>::serialize_size_is_const) {
+        payload_size += sizeof(uint64_t);
+      }
+      return payload_size;
+    }
+
+    /// serializes \p obj into a buffer registered for remote access (rendezvous protocol)
+    /// \param size the value of packed_size(obj)
+    template <typename T>
+    detail::rendezvous_buffer_t register_rendezvous(const T &obj, uint64_t size) {
+      detail::rendezvous_buffer_t rdv;
+      rdv.size = size;
+      rdv.buffer = std::shared_ptr<unsigned char[]>(new unsigned char[size]);
+      pack(obj, rdv.buffer.get(), 0);
+      parsec_ce_mem_reg_handle_t lreg;
+      size_t lreg_size;
+      parsec_ce.mem_register(rdv.buffer.get(), PARSEC_MEM_TYPE_NONCONTIGUOUS, size, parsec_datatype_int8_t, size, &lreg,
+                             &lreg_size);
+      rdv.lreg = std::shared_ptr<void>{lreg, [](void *ptr) {
+                                         parsec_ce_mem_reg_handle_t memreg = (parsec_ce_mem_reg_handle_t)ptr;
+                                         parsec_ce.mem_unregister(&memreg);
+                                       }};
+      rdv.lreg_size = lreg_size;
+      return rdv;
+    }
+
+    /// unpacks the rendezvous descriptor at \p pos and pulls the serialized value from the sender;
+    /// \p activate is invoked with the deserialized value once the transfer has completed
+    template <typename T, typename ActivateFn>
+    void get_rendezvous(unsigned char *bytes, uint64_t pos, ActivateFn &&activate) {
+      uint64_t size;
+      std::memcpy(&size, bytes + pos, sizeof(size));
+      pos += sizeof(size);
+      int remote;
+      std::memcpy(&remote, bytes + pos, sizeof(remote));
+      pos += sizeof(remote);
+      assert(remote < world.size());
+      parsec_ce_tag_t cbtag;
+      std::memcpy(&cbtag, bytes + pos, sizeof(cbtag));
+      pos += sizeof(cbtag);
+      int32_t rreg_size_i;
+      std::memcpy(&rreg_size_i, bytes + pos, sizeof(rreg_size_i));
+      pos += sizeof(rreg_size_i);
+      parsec_ce_mem_reg_handle_t rreg = static_cast<parsec_ce_mem_reg_handle_t>(bytes + pos);
+      pos += rreg_size_i;
+      std::intptr_t fn_ptr;
+      std::memcpy(&fn_ptr, bytes + pos, sizeof(fn_ptr));
+      pos += sizeof(fn_ptr);
+
+      auto activation = new detail::rma_rendezvous_activate(
+          size, [this, activate = std::forward<ActivateFn>(activate)](unsigned char *buffer) mutable {
+            T value;
+            unpack(value, buffer, 0);
+            activate(std::move(value));
+            this->count_msg_received();
+            this->world.impl().decrement_inflight_msg();
+          });
+      using ActivationT = std::decay_t<decltype(*activation)>;
+
+      /* register the local memory */
+      parsec_ce_mem_reg_handle_t lreg;
+      size_t lreg_size;
+      parsec_ce.mem_register(activation->buffer(), PARSEC_MEM_TYPE_NONCONTIGUOUS, size, parsec_datatype_int8_t, size,
+                             &lreg, &lreg_size);
+      this->count_msg_sent();  // the transfer is accounted for as a message
+      world.impl().increment_inflight_msg();
+      /* TODO: PaRSEC should treat the remote callback as a tag, not a function pointer! */
+      parsec_ce.get(&parsec_ce, lreg, 0, rreg, 0, size, remote, &detail::get_complete_cb<ActivationT>, activation,
+                    cbtag, &fn_ptr, sizeof(std::intptr_t));
+    }
+
     static void static_set_arg(void *data, std::size_t size, ttg::OpBase *bop) {
       assert(size >= sizeof(msg_header_t) &&
              "Trying to unpack as message that does not hold enough bytes to represent a single header");
@@ -950,6 +1874,7 @@ namespace ttg_parsec {
       derivedT *obj = reinterpret_cast<derivedT *>(bop);
       switch(hd->fn_id) {
         case msg_header_t::MSG_SET_ARG:
+        case msg_header_t::MSG_SET_ARG_RENDEZVOUS:
         {
           if (-1 != hd->param_id) {
             assert(hd->param_id >= 0);
@@ -992,6 +1917,7 @@ namespace ttg_parsec {
         default:
           abort();
       }
+      obj->count_msg_received();
     }
 
     /** Returns the task memory pool owned by the calling thread */
@@ -1066,10 +1992,18 @@ namespace ttg_parsec {
         if constexpr (!ttg::meta::is_empty_tuple_v<input_refs_tuple_type> && !std::is_void_v<valueT>) {
           using decvalueT = std::decay_t<valueT>;
           if constexpr (!ttg::has_split_metadata<decvalueT>::value) {
-            decvalueT val;
-            unpack(val, msg->bytes, pos);
+            if (msg_header_t::MSG_SET_ARG_RENDEZVOUS == msg->op_id.fn_id) {
+              get_rendezvous<decvalueT>(msg->bytes, pos,
+                                        [this, keylist = std::move(keylist), num_keys](decvalueT &&val) mutable {
+                                          set_arg_from_msg_keylist<i>(ttg::span<keyT>(&keylist[0], num_keys),
+                                                                      std::move(val));
+                                        });
+            } else {
+              decvalueT val;
+              unpack(val, msg->bytes, pos);
 
-            set_arg_from_msg_keylist<i>(ttg::span<keyT>(&keylist[0], num_keys), std::move(val));
+              set_arg_from_msg_keylist<i>(ttg::span<keyT>(&keylist[0], num_keys), std::move(val));
+            }
           } else {
             /* unpack the header and start the RMA transfers */
             ttg::SplitMetadataDescriptor<decvalueT> descr;
@@ -1108,8 +2042,10 @@ namespace ttg_parsec {
                   new detail::rma_delayed_activate(std::move(keylist), descr.create_from_metadata(metadata), num_iovecs,
                                                   [this, num_keys](std::vector<keyT> &&keylist, valueT &&value) {
                                                     set_arg_from_msg_keylist<i>(keylist, value);
+                                                    this->count_msg_received();
                                                     this->world.impl().decrement_inflight_msg();
                                                   });
+              this->count_msg_sent();  // the transfers are accounted for as a message
               auto &val = activation->value();
 
               using ActivationT = std::decay_t<decltype(*activation)>;
@@ -1166,9 +2102,14 @@ namespace ttg_parsec {
       } else if constexpr (ttg::meta::is_void_v<keyT> && !ttg::meta::is_empty_tuple_v<input_refs_tuple_type> &&
                            !std::is_void_v<valueT>) {
         using decvalueT = std::decay_t<valueT>;
-        decvalueT val;
-        unpack(val, msg->bytes, 0);
-        set_arg<i, keyT, valueT>(std::move(val));
+        if (msg_header_t::MSG_SET_ARG_RENDEZVOUS == msg->op_id.fn_id) {
+          get_rendezvous<decvalueT>(msg->bytes, 0,
+                                    [this](decvalueT &&val) { set_arg<i, keyT, valueT>(std::move(val)); });
+        } else {
+          decvalueT val;
+          unpack(val, msg->bytes, 0);
+          set_arg<i, keyT, valueT>(std::move(val));
+        }
         // case 5
       } else if constexpr (ttg::meta::is_void_v<keyT> && !ttg::meta::is_empty_tuple_v<input_refs_tuple_type> &&
                            std::is_void_v<valueT>) {
@@ -1304,15 +2245,16 @@ namespace ttg_parsec {
         }
       }
 
-      parsec_key_t hk = 0;
       if constexpr (!keyT_is_Void) {
-        hk = reinterpret_cast<parsec_key_t>(&key);
         assert(keymap(key) == world.rank());
       }
+      const detail::hashed_key_t<keyT> hkey(key);
+      const parsec_key_t hk = hkey.pkey();
 
       task_t *task;
       auto &world_impl = world.impl();
       auto &reducer = std::get<i>(input_reducers);
+      [[maybe_unused]] void *queue = nullptr;  // the queue of an asynchronously reduced input, see reduction_queue
       bool release = false;
       bool remove_from_hash = true;
       /* If we have only one input and no reducer on that input we can skip the hash table */
@@ -1321,19 +2263,55 @@ namespace ttg_parsec {
         if (nullptr == (task = (task_t *)parsec_hash_table_nolock_find(&tasks_table, hk))) {
           task = create_new_task(key);
           world_impl.increment_created();
+          this->count_task_created();
           parsec_hash_table_nolock_insert(&tasks_table, &task->op_ht_item);
         }
+        if constexpr (!valueT_is_Void) {
+          if (reducer && async_reducers[i])
+            queue = reduction_queue<i>(task);
+          else if (reducer && commutative_reducers[i]) {
+            if (nullptr == task->partials[i])
+              task->partials[i] =
+                  new ttg::detail::partial_reduction<std::decay_t<valueT>>(num_partials, task->stream[i].goal);
+            // N.B. announce the contribution while holding the task, so that the stream is not completed under it
+            partials<i>(task)->enter();
+          }
+        }
         parsec_hash_table_unlock_bucket(&tasks_table, hk);
       } else {
         task = create_new_task(key);
         world_impl.increment_created();
+        this->count_task_created();
         remove_from_hash = false;
       }
 
       constexpr const bool input_is_const = std::is_const_v<std::tuple_element_t<i, input_args_type>>;
       ttg_data_copy_t *copy = nullptr;
 
-      if (reducer) {  // is this a streaming input? reduce the received value
+      if (!valueT_is_Void && reducer && async_reducers[i]) {
+        // asynchronously reduced streaming input: queue the value for the reduction task
+        if constexpr (!valueT_is_Void) {
+          // N.B. the reduction task resets task->queues[i] under the bucket lock, use the queue obtained under it
+          using queue_t = std::remove_pointer_t<decltype(reduction_queue<i>(task))>;
+          if (static_cast<queue_t *>(queue)->push(new typename queue_t::node{nullptr, std::forward<Value>(value)}))
+            submit_reduction_task<i>(task);
+        }
+        return;
+      } else if (!valueT_is_Void && reducer && commutative_reducers[i]) {
+        // streaming input with a commutative reducer: reduce into this thread's partial result, without locking
+        if constexpr (!valueT_is_Void) {
+          ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
+          // N.B. the task may be completed by another contributor as soon as this contribution is out, must not touch
+          //      it unless told to complete the stream
+          if (!partials<i>(task)->reduce(reducer, std::move(reduced_value))) return;
+          parsec_hash_table_lock_bucket(&tasks_table, hk);
+          release = complete_partials<i>(task);
+          parsec_hash_table_unlock_bucket(&tasks_table, hk);
+          if (!release) return;
+        }
+      } else if (reducer) {  // is this a streaming input? reduce the received value
+        // the reducer consumes the value: move it if possible, otherwise copy it before locking
+        [[maybe_unused]] ttg::meta::moved_or_copied_t<Value> reduced_value = std::forward<Value>(value);
         // N.B. Right now reductions are done eagerly, without spawning tasks
         //      this means we must lock
         parsec_hash_table_lock_bucket(&tasks_table, hk);
@@ -1341,16 +2319,11 @@ namespace ttg_parsec {
         if constexpr (!ttg::meta::is_void_v<valueT>) {  // for data values
           // have a value already? if not, set, otherwise reduce
           if (nullptr == (copy = reinterpret_cast<ttg_data_copy_t *>(task->parsec_task.data[i].data_in))) {
-            using decay_valueT = std::decay_t<valueT>;
-            copy = detail::create_new_datacopy(std::forward<Value>(value));
+            copy = detail::create_new_datacopy(std::move(reduced_value));
             task->parsec_task.data[i].data_in = copy;
           } else {
-            // TODO: Ask Ed -- Why do we need a copy of value here?
-            valueT value_copy = value;  // use constexpr if to avoid making a copy if given nonconst rvalue
-            *reinterpret_cast<std::decay_t<valueT> *>(copy->device_private) =
-                std::move(reducer(reinterpret_cast<std::decay_t<valueT> &&>(
-                                      *reinterpret_cast<std::decay_t<valueT> *>(copy->device_private)),
-                                  std::move(value_copy)));
+            auto &accumulator = *reinterpret_cast<std::decay_t<valueT> *>(copy->device_private);
+            accumulator = reducer(std::move(accumulator), std::move(reduced_value));
           }
         } else {
           reducer();  // even if this was a control input, must execute the reducer for possible side effects
@@ -1397,20 +2370,178 @@ namespace ttg_parsec {
       }
       if (release) {
         if (remove_from_hash) {
-          release_task<true>(this, task, task_list);
+          release_task<true>(this, task, task_list, true);
         } else {
-          release_task<false>(this, task, task_list);
+          release_task<false>(this, task, task_list, true);
+        }
+      }
+    }
+
+    /// @return the queue of values of asynchronously reduced streaming input \c i of \p task , created if needed
+    /// \note the caller must hold the hash-table bucket of \p task , unless the queue exists
+    template <std::size_t i>
+    auto *reduction_queue(task_t *task) {
+      using queue_t = detail::reduction_queue<std::decay_t<std::tuple_element_t<i, input_values_full_tuple_type>>>;
+      if (nullptr == task->queues[i]) task->queues[i] = new queue_t;
+      return static_cast<queue_t *>(task->queues[i]);
+    }
+
+    /// submits a task that reduces the queued values of streaming input \c i of \p task
+    template <std::size_t i>
+    void submit_reduction_task(task_t *task) {
+      auto &world_impl = world.impl();
+      parsec_thread_mempool_t *mempool = get_task_mempool();
+      task_t *rtask;
+      if constexpr (ttg::meta::is_void_v<keyT>)
+        rtask = new (parsec_thread_mempool_allocate(mempool))
+            task_t(mempool, &this->self, world_impl.taskpool(), this, task->parsec_task.priority);
+      else
+        rtask = new (parsec_thread_mempool_allocate(mempool))
+            task_t(task->key, mempool, &this->self, world_impl.taskpool(), this, task->parsec_task.priority);
+      rtask->reduced_task = task;
+      for (auto &fn : rtask->function_template_class_ptr)
+        fn = reinterpret_cast<detail::parsec_static_op_t>(&Op::static_reduce<i>);
+      world_impl.increment_created();
+      this->count_task_created();
+      world_impl.increment_sent_to_sched();
+      __parsec_schedule(task_execution_stream(rtask), &rtask->parsec_task, 0);
+    }
+
+    /// body of the reduction tasks of streaming input \c i
+    template <std::size_t i>
+    static void static_reduce(parsec_task_t *parsec_task) {
+      task_t *rtask = (task_t *)parsec_task;
+      opT *op = (opT *)rtask->object_ptr;
+      op->template reduce_queued<i>(static_cast<task_t *>(rtask->reduced_task));
+    }
+
+    /// reduces the queued values of streaming input \c i of \p task until none are pending, releases \p task
+    /// once the stream is complete
+    template <std::size_t i>
+    void reduce_queued(task_t *task) {
+      using valueT = std::decay_t<std::tuple_element_t<i, input_values_full_tuple_type>>;
+      auto &reducer = std::get<i>(input_reducers);
+      auto *queue = reduction_queue<i>(task);
+      bool complete = false;
+      while (true) {
+        std::size_t n = 0;
+        std::size_t nvalues = 0;
+        for (auto *node = queue->pop_all(); node != nullptr; ++n) {
+          if (node->value) {
+            auto *copy = reinterpret_cast<ttg_data_copy_t *>(task->parsec_task.data[i].data_in);
+            if (nullptr == copy) {
+              task->parsec_task.data[i].data_in = detail::create_new_datacopy(std::move(*node->value));
+            } else {
+              auto &accumulator = *reinterpret_cast<valueT *>(copy->device_private);
+              accumulator = reducer(std::move(accumulator), std::move(*node->value));
+            }
+            ++nvalues;
+          } else
+            complete = true;  // finalized
+          auto *next = node->next;
+          delete node;
+          node = next;
+        }
+        if (nvalues > 0) {
+          const auto hk = task->pkey();
+          parsec_hash_table_lock_bucket(&tasks_table, hk);
+          task->stream[i].size += nvalues;
+          complete = complete || (task->stream[i].size == task->stream[i].goal);
+          parsec_hash_table_unlock_bucket(&tasks_table, hk);
+        }
+        // N.B. a sender counts its value as pending before pushing it, hence the queue can be destroyed only once
+        //      every value is processed; values still being pushed when the stream completes are waited for
+        const bool idle = queue->processed(n);
+        if (complete && idle) {
+          // N.B. this assumes that the stream size is set before data starts flowing, like the eager path
+          const auto hk = task->pkey();
+          parsec_hash_table_lock_bucket(&tasks_table, hk);
+          task->queues[i] = nullptr;
+          parsec_hash_table_unlock_bucket(&tasks_table, hk);
+          delete queue;
+          release_task<true>(this, task);
+          return;
+        }
+        if (idle) return;  // the next sender submits a new reduction task
+      }
+    }
+
+    /// @return the partial results of commutative streaming input \c i of \p task
+    template <std::size_t i>
+    auto *partials(task_t *task) {
+      using partials_t =
+          ttg::detail::partial_reduction<std::decay_t<std::tuple_element_t<i, input_values_full_tuple_type>>>;
+      return static_cast<partials_t *>(task->partials[i]);
+    }
+
+    /// completes commutative streaming input \c i of \p task , unless it is not closed, contributions are in flight
+    /// or it has been completed already (see ttg::detail::partial_reduction::try_complete)
+    /// @return true if the stream was completed, i.e. the partial results have been combined into the input value and
+    ///         the caller must release \p task
+    /// \note the caller must hold the hash-table bucket of \p task
+    template <std::size_t i>
+    bool complete_partials(task_t *task) {
+      auto *p = partials<i>(task);
+      if (!p->try_complete()) return false;
+      task->stream[i].size = p->size();
+      combine_partials<i>(task);
+      return true;
+    }
+
+    /// combines the partial results of commutative streaming input \c i of \p task into its input value
+    template <std::size_t i>
+    void combine_partials(task_t *task) {
+      using valueT = std::tuple_element_t<i, input_values_full_tuple_type>;
+      if constexpr (!ttg::meta::is_void_v<valueT>) {
+        using partials_t = ttg::detail::partial_reduction<std::decay_t<valueT>>;
+        auto *partials = static_cast<partials_t *>(task->partials[i]);
+        if (nullptr != partials) {
+          auto value = partials->combine(std::get<i>(input_reducers));
+          if (value) task->parsec_task.data[i].data_in = detail::create_new_datacopy(std::move(*value));
+          delete partials;
+          task->partials[i] = nullptr;
         }
       }
     }
 
+    /// @return true if a task of this op that became ready on the calling thread is to be executed by it right away
+    /// \note only tasks made ready by another task are executed inline, hence the thread is a PaRSEC worker
+    bool execute_inline() {
+      const auto &policy = this->get_execution_policy();
+      return !derived_has_cuda_op() && nullptr != parsec_ttg_caller && policy && *policy == ttg::Execution::Inline &&
+             1 + parsec_ttg_inline_depth < this->get_max_inline_depth();
+    }
+
+    /// @return the execution stream whose queue should receive ready task \p task : the one of the worker thread
+    ///         given by the threadmap, if any, else the one of the calling thread
+    parsec_execution_stream_t *task_execution_stream(task_t *task) {
+      auto &world_impl = world.impl();
+      if (!threadmap) return world_impl.execution_stream();
+      if constexpr (ttg::meta::is_void_v<keyT>)
+        return world_impl.execution_stream(threadmap());
+      else
+        return world_impl.execution_stream(threadmap(task->key));
+    }
+
+    /// executes ready task \p task on the calling thread, as if it was executed by PaRSEC's scheduler
+    static void execute_inline(parsec_execution_stream_t *es, task_t *task) {
+      parsec_task_t *caller = parsec_ttg_caller;
+      parsec_ttg_caller = nullptr;
+      ++parsec_ttg_inline_depth;
+      if (PARSEC_HOOK_RETURN_DONE == __parsec_execute(es, &task->parsec_task))
+        __parsec_complete_execution(es, &task->parsec_task);
+      --parsec_ttg_inline_depth;
+      parsec_ttg_caller = caller;
+    }
+
     template<bool RemoveFromHash>
     static void release_task_to_scheduler(void *op_ptr, detail::parsec_ttg_task_base_t *base_task) {
       release_task<RemoveFromHash>(op_ptr, base_task, nullptr);
     }
 
     template<bool RemoveFromHash>
-    static void release_task(void *op_ptr, detail::parsec_ttg_task_base_t *base_task, parsec_list_t *task_list = nullptr) {
+    static void release_task(void *op_ptr, detail::parsec_ttg_task_base_t *base_task, parsec_list_t *task_list = nullptr,
+                             bool may_execute_inline = false) {
       constexpr const bool keyT_is_Void = ttg::meta::is_void_v<keyT>;
       task_t *task = static_cast<task_t*>(base_task);
       opT &op = *reinterpret_cast<opT *>(op_ptr);
@@ -1427,7 +2558,8 @@ namespace ttg_parsec {
         }
 
         world_impl.increment_sent_to_sched();
-        parsec_execution_stream_t *es = world_impl.execution_stream();
+        parsec_execution_stream_t *es = op.task_execution_stream(task);
+        const bool on_calling_thread = es == world_impl.execution_stream();
         parsec_key_t hk = task->pkey();
         if (op.tracing()) {
           if constexpr (!keyT_is_Void) {
@@ -1437,8 +2569,11 @@ namespace ttg_parsec {
           }
         }
         if (RemoveFromHash) parsec_hash_table_remove(&op.tasks_table, hk);
-        if (nullptr == task_list) {
-          __parsec_schedule(es, &task->parsec_task, 0);
+        if (nullptr == task_list || !on_calling_thread) {
+          if (may_execute_inline && on_calling_thread && op.execute_inline())
+            execute_inline(es, task);
+          else
+            __parsec_schedule(es, &task->parsec_task, 0);
         } else {
           parsec_list_prepend(task_list, &task->parsec_task.super);
         }
@@ -1490,21 +2625,40 @@ namespace ttg_parsec {
       // the target task is remote. Pack the information and send it to
       // the corresponding peer.
       // TODO do we need to copy value?
-      using msg_t = detail::msg_t;
       auto &world_impl = world.impl();
       uint64_t pos = 0;
-      std::unique_ptr<msg_t> msg = std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                                           msg_header_t::MSG_SET_ARG, i, 1);
       using decvalueT = std::decay_t<Value>;
+      /* size the message buffer; the size of split-metadata payloads is only known after registration */
+      std::size_t payload_size = sizeof(detail::msg_t::bytes);
+      auto fn_id = msg_header_t::MSG_SET_ARG;
+      detail::rendezvous_buffer_t rendezvous;
+      if constexpr (!ttg::has_split_metadata<decvalueT>::value) {
+        std::size_t key_size = 0;
+        if constexpr (!ttg::meta::is_void_v<Key>) key_size = packed_size(key);
+        const std::size_t value_size = packed_size(value);
+        if (sizeof(msg_header_t) + key_size + value_size <= world_impl.eager_limit()) {
+          payload_size = key_size + value_size;
+        } else {
+          /* too large to be sent eagerly, let the receiver pull the value */
+          rendezvous = register_rendezvous(value, value_size);
+          payload_size = key_size + rendezvous.packed_size();
+          fn_id = msg_header_t::MSG_SET_ARG_RENDEZVOUS;
+        }
+      }
+      auto msg = detail::msg_pool::allocate(payload_size, get_instance_id(), world_impl.taskpool()->taskpool_id, fn_id,
+                                            i, 1);
       /* pack the key */
-      msg->op_id.num_keys = 0;
+      msg->num_keys = 0;
       if constexpr (!ttg::meta::is_void_v<Key>) {
-        pos = pack(key, msg->bytes, pos);
-        msg->op_id.num_keys = 1;
+        pos = pack(key, msg.bytes(), pos);
+        msg->num_keys = 1;
       }
       if constexpr (!ttg::has_split_metadata<decvalueT>::value) {
         // std::cout << "set_arg_from_msg unpacking from offset " << sizeof(keyT) << std::endl;
-        pos = pack(value, msg->bytes, pos);
+        if (msg_header_t::MSG_SET_ARG_RENDEZVOUS == fn_id)
+          pos = rendezvous.pack(world.rank(), msg.bytes(), pos);
+        else
+          pos = pack(value, msg.bytes(), pos);
       } else {
         ttg_data_copy_t *copy;
         copy = detail::find_copy_in_task(parsec_ttg_caller, &value);
@@ -1518,24 +2672,24 @@ namespace ttg_parsec {
         auto metadata = descr.get_metadata(value);
         size_t metadata_size = sizeof(metadata);
         /* pack the metadata */
-        std::memcpy(msg->bytes + pos, &metadata, metadata_size);
+        std::memcpy(msg.bytes() + pos, &metadata, metadata_size);
         pos += metadata_size;
         /* pack the local rank */
         int rank = world.rank();
-        std::memcpy(msg->bytes + pos, &rank, sizeof(rank));
+        std::memcpy(msg.bytes() + pos, &rank, sizeof(rank));
         pos += sizeof(rank);
 
         auto iovecs = descr.get_data(*static_cast<decvalueT *>(copy->device_private));
 
         int32_t num_iovs = std::distance(std::begin(iovecs), std::end(iovecs));
-        std::memcpy(msg->bytes + pos, &num_iovs, sizeof(num_iovs));
+        std::memcpy(msg.bytes() + pos, &num_iovs, sizeof(num_iovs));
         pos += sizeof(num_iovs);
 
         /* TODO: at the moment, the tag argument to parsec_ce.get() is treated as a
          * raw function pointer instead of a preregistered AM tag, so play that game.
          * Once this is fixed in PaRSEC we need to use parsec_ttg_rma_tag instead! */
         parsec_ce_tag_t cbtag = reinterpret_cast<parsec_ce_tag_t>(&detail::get_remote_complete_cb);
-        std::memcpy(msg->bytes + pos, &cbtag, sizeof(cbtag));
+        std::memcpy(msg.bytes() + pos, &cbtag, sizeof(cbtag));
         pos += sizeof(cbtag);
 
         /**
@@ -1553,9 +2707,9 @@ namespace ttg_parsec {
                                                   parsec_ce.mem_unregister(&memreg);
                                                 }};
           int32_t lreg_size_i = lreg_size;
-          std::memcpy(msg->bytes + pos, &lreg_size_i, sizeof(lreg_size_i));
+          std::memcpy(msg.bytes() + pos, &lreg_size_i, sizeof(lreg_size_i));
           pos += sizeof(lreg_size_i);
-          std::memcpy(msg->bytes + pos, lreg, lreg_size_i);
+          std::memcpy(msg.bytes() + pos, lreg, lreg_size_i);
           pos += lreg_size_i;
           /* TODO: can we avoid the extra indirection of going through std::function? */
           std::function<void(void)> *fn = new std::function<void(void)>([=]() mutable {
@@ -1565,16 +2719,13 @@ namespace ttg_parsec {
             lreg_ptr.reset();
           });
           std::intptr_t fn_ptr{reinterpret_cast<std::intptr_t>(fn)};
-          std::memcpy(msg->bytes + pos, &fn_ptr, sizeof(fn_ptr));
+          std::memcpy(msg.bytes() + pos, &fn_ptr, sizeof(fn_ptr));
           pos += sizeof(fn_ptr);
         }
       }
-      parsec_taskpool_t *tp = world_impl.taskpool();
-      tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-      tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-      // std::cout << "Sending AM with " << msg->op_id.num_keys << " keys " << std::endl;
-      parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                        sizeof(msg_header_t) + pos);
+      // std::cout << "Sending AM with " << msg->num_keys << " keys " << std::endl;
+      this->count_msg_sent();
+      world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
     }
 
     // case 3
@@ -1589,7 +2740,6 @@ namespace ttg_parsec {
         // create PaRSEC task
         // and give it to the scheduler
         task_t *task;
-        parsec_execution_stream_s *es = world_impl.execution_stream();
         parsec_thread_mempool_t *mempool = get_task_mempool();
         char *taskobj = (char *)parsec_thread_mempool_allocate(mempool);
 
@@ -1602,22 +2752,19 @@ namespace ttg_parsec {
               reinterpret_cast<detail::parsec_static_op_t>(&Op::static_op_noarg<ttg::ExecutionSpace::CUDA>);
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": creating task");
         world_impl.increment_created();
+        this->count_task_created();
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : ", key, ": submitting task for op ");
         world_impl.increment_sent_to_sched();
-        __parsec_schedule(es, &task->parsec_task, 0);
+        __parsec_schedule(task_execution_stream(task), &task->parsec_task, 0);
       } else {
-        using msg_t = detail::msg_t;
         // We pass -1 to signal that we just need to call set_arg(key) on the other end
-        std::unique_ptr<msg_t> msg =
-            std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id, msg_header_t::MSG_SET_ARG, -1, 1);
+        auto msg = detail::msg_pool::allocate(packed_size(key), get_instance_id(), world_impl.taskpool()->taskpool_id,
+                                              msg_header_t::MSG_SET_ARG, -1, 1);
 
         uint64_t pos = 0;
-        pos = pack(key, msg->bytes, pos);
-        parsec_taskpool_t *tp = world_impl.taskpool();
-        tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-        tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-        parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                          sizeof(msg_header_t) + pos);
+        pos = pack(key, msg.bytes(), pos);
+        this->count_msg_sent();
+        world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
       }
     }
 
@@ -1633,7 +2780,6 @@ namespace ttg_parsec {
         // and give it to the scheduler
         task_t *task;
         auto &world_impl = world.impl();
-        parsec_execution_stream_s *es = world_impl.execution_stream();
         parsec_thread_mempool_t *mempool = get_task_mempool();
         task = new (parsec_thread_mempool_allocate(mempool))
             task_t(mempool, &this->self, world_impl.taskpool(), this, priomap());
@@ -1644,9 +2790,10 @@ namespace ttg_parsec {
               reinterpret_cast<detail::parsec_static_op_t>(&Op::static_op_noarg<ttg::ExecutionSpace::CUDA>);
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : creating task");
         world_impl.increment_created();
+        this->count_task_created();
         if (tracing()) ttg::print(world.rank(), ":", get_name(), " : submitting task for op ");
         world_impl.increment_sent_to_sched();
-        __parsec_schedule(es, &task->parsec_task, 0);
+        __parsec_schedule(task_execution_stream(task), &task->parsec_task, 0);
       }
     }
 
@@ -1664,6 +2811,26 @@ namespace ttg_parsec {
         }
     }
 
+    /// splits the keys in [\p begin, \p end), all owned by one rank, into consecutive ranges that each fit in one
+    /// active message together with the header and the \p tail_size bytes that follow the keys,
+    /// and calls \p send(range_begin, range_end, keys_size) for each range
+    template <typename Iterator, typename SendFn>
+    void split_keys_into_msgs(Iterator begin, Iterator end, std::size_t tail_size, SendFn &&send) {
+      constexpr std::size_t max_msg_size = WorldImpl::PARSEC_TTG_MAX_AM_SIZE;
+      while (begin < end) {
+        auto msg_end = begin;
+        std::size_t keys_size = 0;
+        /* every message carries at least one key */
+        do {
+          keys_size += packed_size(*msg_end);
+          ++msg_end;
+        } while (msg_end < end && sizeof(msg_header_t) + keys_size + packed_size(*msg_end) + tail_size <= max_msg_size);
+        assert(sizeof(msg_header_t) + keys_size + tail_size <= max_msg_size);
+        send(begin, msg_end, keys_size);
+        begin = msg_end;
+      }
+    }
+
     template <std::size_t i, typename Key, typename Value>
     std::enable_if_t<!ttg::meta::is_void_v<Key> && !std::is_void_v<std::decay_t<Value>> &&
                          !ttg::has_split_metadata<std::decay_t<Value>>::value,
@@ -1689,43 +2856,50 @@ namespace ttg_parsec {
           return rank_a < rank_b;
         });
 
-        using msg_t = detail::msg_t;
-        local_begin = keylist_sorted.end();
         auto &world_impl = world.impl();
-        std::unique_ptr<msg_t> msg = std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                                             msg_header_t::MSG_SET_ARG, i);
-
-        parsec_taskpool_t *tp = world_impl.taskpool();
+        /* the value is sent eagerly if a message with any one key and the value fits within the eager limit, else the
+         * receivers pull it from a single buffer */
+        std::size_t max_key_size = 0;
+        for (auto &&key : keylist_sorted) max_key_size = std::max<std::size_t>(max_key_size, packed_size(key));
+        const std::size_t value_size = packed_size(value);
+        auto fn_id = msg_header_t::MSG_SET_ARG;
+        detail::rendezvous_buffer_t rendezvous;
+        std::size_t tail_size = value_size;
+        if (sizeof(msg_header_t) + max_key_size + value_size > world_impl.eager_limit()) {
+          rendezvous = register_rendezvous(value, value_size);
+          fn_id = msg_header_t::MSG_SET_ARG_RENDEZVOUS;
+          tail_size = rendezvous.packed_size();
+        }
 
         for (auto it = keylist_sorted.begin(); it < keylist_sorted.end(); /* increment inline */) {
           auto owner = keymap(*it);
+          auto owner_end =
+              std::find_if_not(it + 1, keylist_sorted.end(), [&](const Key &key) { return keymap(key) == owner; });
           if (owner == rank) {
             /* make sure we don't lose local keys */
             local_begin = it;
-            local_end =
-                std::find_if_not(++it, keylist_sorted.end(), [&](const Key &key) { return keymap(key) == rank; });
-            it = local_end;
+            local_end = owner_end;
+            it = owner_end;
             continue;
           }
 
-          /* pack all keys for this owner */
-          int num_keys = 0;
-          uint64_t pos = 0;
-          do {
-            ++num_keys;
-            pos = pack(*it, msg->bytes, pos);
-            ++it;
-          } while (it < keylist_sorted.end() && keymap(*it) == owner);
-          msg->op_id.num_keys = num_keys;
-
-          /* TODO: use RMA to transfer the value */
-          pos = pack(value, msg->bytes, pos);
-
-          /* Send the message */
-          tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-          tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-          parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                            sizeof(msg_header_t) + pos);
+          /* send the keys of this owner in as many messages as needed to stay within the message size */
+          split_keys_into_msgs(it, owner_end, tail_size, [&](auto begin, auto end, std::size_t keys_size) {
+            auto msg = detail::msg_pool::allocate(keys_size + tail_size, get_instance_id(),
+                                                  world_impl.taskpool()->taskpool_id, fn_id, i,
+                                                  static_cast<int>(std::distance(begin, end)));
+            uint64_t pos = 0;
+            for (auto key_it = begin; key_it < end; ++key_it) pos = pack(*key_it, msg.bytes(), pos);
+            if (msg_header_t::MSG_SET_ARG_RENDEZVOUS == fn_id)
+              pos = rendezvous.pack(rank, msg.bytes(), pos);
+            else
+              pos = pack(value, msg.bytes(), pos);
+
+            /* Send the message */
+            this->count_msg_sent();
+            world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
+          });
+          it = owner_end;
         }
         /* handle local keys */
         broadcast_arg_local<i>(local_begin, local_end, value);
@@ -1783,91 +2957,82 @@ namespace ttg_parsec {
                                                                  }}));
         }
 
-        using msg_t = detail::msg_t;
         auto &world_impl = world.impl();
-        std::unique_ptr<msg_t> msg = std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                                             msg_header_t::MSG_SET_ARG, i);
         auto metadata = descr.get_metadata(value);
         size_t metadata_size = sizeof(metadata);
+        /* the metadata, rank, iovec count, callback tag and registrations that follow the keys in every message */
+        std::size_t tail_size = metadata_size + sizeof(rank) + sizeof(num_iovs) + sizeof(parsec_ce_tag_t);
+        for (auto &&memreg : memregs) tail_size += sizeof(int32_t) + memreg.first + sizeof(std::intptr_t);
 
         ttg_data_copy_t *copy;
         copy = detail::find_copy_in_task(parsec_ttg_caller, &value);
         assert(nullptr != copy);
 
-        parsec_taskpool_t *tp = world_impl.taskpool();
         for (auto it = keylist_sorted.begin(); it < keylist_sorted.end(); /* increment done inline */) {
           auto owner = keymap(*it);
+          /* find first key of the next owner */
+          auto owner_end =
+              std::find_if_not(it + 1, keylist_sorted.end(), [&](const Key &key) { return keymap(key) == owner; });
           if (owner == rank) {
             local_begin = it;
-            /* find first non-local key */
-            local_end =
-                std::find_if_not(++it, keylist_sorted.end(), [&](const Key &key) { return keymap(key) == rank; });
-            it = local_end;
+            local_end = owner_end;
+            it = owner_end;
             continue;
           }
 
-          /* count keys and set it afterwards */
-          uint64_t pos = 0;
-          /* pack all keys for this owner */
-          int num_keys = 0;
-          do {
-            ++num_keys;
-            pos = pack(*it, msg->bytes, pos);
-            ++it;
-          } while (it < keylist_sorted.end() && keymap(*it) == owner);
-          msg->op_id.num_keys = num_keys;
-
-          /* pack the metadata */
-          std::memcpy(msg->bytes + pos, &metadata, metadata_size);
-          pos += metadata_size;
-          /* pack the local rank */
-          int rank = world.rank();
-          std::memcpy(msg->bytes + pos, &rank, sizeof(rank));
-          pos += sizeof(rank);
-          /* pack the number of iovecs */
-          std::memcpy(msg->bytes + pos, &num_iovs, sizeof(num_iovs));
-          pos += sizeof(num_iovs);
-
-          /* TODO: at the moment, the tag argument to parsec_ce.get() is treated as a
-           * raw function pointer instead of a preregistered AM tag, so play that game.
-           * Once this is fixed in PaRSEC we need to use parsec_ttg_rma_tag instead! */
-          parsec_ce_tag_t cbtag = reinterpret_cast<parsec_ce_tag_t>(&detail::get_remote_complete_cb);
-          std::memcpy(msg->bytes + pos, &cbtag, sizeof(cbtag));
-          pos += sizeof(cbtag);
-
-          /**
-           * pack the registration handles
-           * memory layout: [<lreg_size, lreg, lreg_fn>, ...]
-           */
-          int idx = 0;
-          for (auto &&iov : iovs) {
-            // auto [lreg_size, lreg_ptr] = memregs[idx];
-            int32_t lreg_size;
-            std::shared_ptr<void> lreg_ptr;
-            std::tie(lreg_size, lreg_ptr) = memregs[idx];
-            std::memcpy(msg->bytes + pos, &lreg_size, sizeof(lreg_size));
-            pos += sizeof(lreg_size);
-            std::memcpy(msg->bytes + pos, lreg_ptr.get(), lreg_size);
-            pos += lreg_size;
-            /* create a function that will be invoked upon RMA completion at the target */
-            std::shared_ptr<void> lreg_ptr_v = lreg_ptr;
-            /* mark another reader on the copy */
-            copy = detail::register_data_copy<valueT>(copy, nullptr, true);
-            std::function<void(void)> *fn = new std::function<void(void)>([=]() mutable {
-              /* shared_ptr of value and registration captured by value so resetting
-               * them here will eventually release the memory/registration */
-              detail::release_data_copy(copy);
-              lreg_ptr_v.reset();
-            });
-            std::intptr_t fn_ptr{reinterpret_cast<std::intptr_t>(fn)};
-            std::memcpy(msg->bytes + pos, &fn_ptr, sizeof(fn_ptr));
-            pos += sizeof(fn_ptr);
-            ++idx;
-          }
-          tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-          tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-          parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                            sizeof(msg_header_t) + pos);
+          /* send the keys of this owner in as many messages as needed to stay within the message size */
+          split_keys_into_msgs(it, owner_end, tail_size, [&](auto begin, auto end, std::size_t keys_size) {
+            auto msg = detail::msg_pool::allocate(keys_size + tail_size, get_instance_id(),
+                                                  world_impl.taskpool()->taskpool_id, msg_header_t::MSG_SET_ARG, i,
+                                                  static_cast<int>(std::distance(begin, end)));
+            uint64_t pos = 0;
+            /* pack the keys of this message */
+            for (auto key_it = begin; key_it < end; ++key_it) pos = pack(*key_it, msg.bytes(), pos);
+
+            /* pack the metadata */
+            std::memcpy(msg.bytes() + pos, &metadata, metadata_size);
+            pos += metadata_size;
+            /* pack the local rank */
+            std::memcpy(msg.bytes() + pos, &rank, sizeof(rank));
+            pos += sizeof(rank);
+            /* pack the number of iovecs */
+            std::memcpy(msg.bytes() + pos, &num_iovs, sizeof(num_iovs));
+            pos += sizeof(num_iovs);
+
+            /* TODO: at the moment, the tag argument to parsec_ce.get() is treated as a
+             * raw function pointer instead of a preregistered AM tag, so play that game.
+             * Once this is fixed in PaRSEC we need to use parsec_ttg_rma_tag instead! */
+            parsec_ce_tag_t cbtag = reinterpret_cast<parsec_ce_tag_t>(&detail::get_remote_complete_cb);
+            std::memcpy(msg.bytes() + pos, &cbtag, sizeof(cbtag));
+            pos += sizeof(cbtag);
+
+            /**
+             * pack the registration handles
+             * memory layout: [<lreg_size, lreg, lreg_fn>, ...]
+             */
+            for (auto &&[lreg_size, lreg_ptr] : memregs) {
+              std::memcpy(msg.bytes() + pos, &lreg_size, sizeof(lreg_size));
+              pos += sizeof(lreg_size);
+              std::memcpy(msg.bytes() + pos, lreg_ptr.get(), lreg_size);
+              pos += lreg_size;
+              /* create a function that will be invoked upon RMA completion at the target */
+              std::shared_ptr<void> lreg_ptr_v = lreg_ptr;
+              /* mark another reader on the copy */
+              copy = detail::register_data_copy<valueT>(copy, nullptr, true);
+              std::function<void(void)> *fn = new std::function<void(void)>([=]() mutable {
+                /* shared_ptr of value and registration captured by value so resetting
+                 * them here will eventually release the memory/registration */
+                detail::release_data_copy(copy);
+                lreg_ptr_v.reset();
+              });
+              std::intptr_t fn_ptr{reinterpret_cast<std::intptr_t>(fn)};
+              std::memcpy(msg.bytes() + pos, &fn_ptr, sizeof(fn_ptr));
+              pos += sizeof(fn_ptr);
+            }
+            this->count_msg_sent();
+            world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
+          });
+          it = owner_end;
         }
         /* handle local keys */
         broadcast_arg_local<i>(local_begin, local_end, value);
@@ -1915,32 +3080,30 @@ namespace ttg_parsec {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), ":", key, " : forwarding stream size for terminal ", i);
         }
-        using msg_t = detail::msg_t;
         auto &world_impl = world.impl();
         uint64_t pos = 0;
-        std::unique_ptr<msg_t> msg =
-            std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                    msg_header_t::MSG_SET_ARGSTREAM_SIZE, i, 1);
+        auto msg = detail::msg_pool::allocate(packed_size(key) + packed_size(size), get_instance_id(),
+                                              world_impl.taskpool()->taskpool_id,
+                                              msg_header_t::MSG_SET_ARGSTREAM_SIZE, i, 1);
         /* pack the key */
-        pos = pack(key, msg->bytes, pos);
-        msg->op_id.num_keys = 1;
-        pos = pack(size, msg->bytes, pos);
-        parsec_taskpool_t *tp = world_impl.taskpool();
-        tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-        tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-        parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                          sizeof(msg_header_t) + pos);
+        pos = pack(key, msg.bytes(), pos);
+        msg->num_keys = 1;
+        pos = pack(size, msg.bytes(), pos);
+        this->count_msg_sent();
+        world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), ":", key, " : setting stream size to ", size, " for terminal ", i);
         }
 
-        auto hk = reinterpret_cast<parsec_key_t>(&key);
+        const detail::hashed_key_t<keyT> hkey(key);
+        const auto hk = hkey.pkey();
         task_t *task;
         parsec_hash_table_lock_bucket(&tasks_table, hk);
         if (nullptr == (task = (task_t *)parsec_hash_table_nolock_find(&tasks_table, hk))) {
           task = create_new_task(key);
           world.impl().increment_created();
+          this->count_task_created();
           parsec_hash_table_nolock_insert(&tasks_table, &task->op_ht_item);
         }
 
@@ -1950,6 +3113,11 @@ namespace ttg_parsec {
         // commit changes
         task->stream[i].goal = size;
         bool release = (task->stream[i].size == task->stream[i].goal);
+        if constexpr (!ttg::meta::is_void_v<std::tuple_element_t<i, input_values_full_tuple_type>>) {
+          // the values of a commutative stream are counted by its partial results, the stream may be complete already
+          if (commutative_reducers[i] && nullptr != task->partials[i])
+            release = partials<i>(task)->set_goal(size) && complete_partials<i>(task);
+        }
         parsec_hash_table_unlock_bucket(&tasks_table, hk);
 
         if (release) release_task<true>(this, task);
@@ -1970,20 +3138,15 @@ namespace ttg_parsec {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : forwarding stream size for terminal ", i);
         }
-        using msg_t = detail::msg_t;
         auto &world_impl = world.impl();
         uint64_t pos = 0;
-        std::unique_ptr<msg_t> msg =
-            std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                    msg_header_t::MSG_SET_ARGSTREAM_SIZE, i, 1);
+        auto msg = detail::msg_pool::allocate(packed_size(size), get_instance_id(), world_impl.taskpool()->taskpool_id,
+                                              msg_header_t::MSG_SET_ARGSTREAM_SIZE, i, 1);
         /* pack the key */
-        msg->op_id.num_keys = 0;
-        pos = pack(size, msg->bytes, pos);
-        parsec_taskpool_t *tp = world_impl.taskpool();
-        tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-        tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-        parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                          sizeof(msg_header_t) + pos);
+        msg->num_keys = 0;
+        pos = pack(size, msg.bytes(), pos);
+        this->count_msg_sent();
+        world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : setting stream size to ", size, " for terminal ", i);
@@ -1995,6 +3158,7 @@ namespace ttg_parsec {
         if (nullptr == (task = (task_t *)parsec_hash_table_nolock_find(&tasks_table, hk))) {
           task = create_new_task(ttg::Void{});
           world.impl().increment_created();
+          this->count_task_created();
           parsec_hash_table_nolock_insert(&tasks_table, &task->op_ht_item);
         }
 
@@ -2004,6 +3168,11 @@ namespace ttg_parsec {
         // commit changes
         task->stream[i].goal = size;
         bool release = (task->stream[i].size == task->stream[i].goal);
+        if constexpr (!ttg::meta::is_void_v<std::tuple_element_t<i, input_values_full_tuple_type>>) {
+          // the values of a commutative stream are counted by its partial results, the stream may be complete already
+          if (commutative_reducers[i] && nullptr != task->partials[i])
+            release = partials<i>(task)->set_goal(size) && complete_partials<i>(task);
+        }
         parsec_hash_table_unlock_bucket(&tasks_table, hk);
 
         if (release) release_task<true>(this, task);
@@ -2022,26 +3191,22 @@ namespace ttg_parsec {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": forwarding stream finalize for terminal ", i);
         }
-        using msg_t = detail::msg_t;
         auto &world_impl = world.impl();
         uint64_t pos = 0;
-        std::unique_ptr<msg_t> msg =
-            std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                    msg_header_t::MSG_FINALIZE_ARGSTREAM_SIZE, i, 1);
+        auto msg = detail::msg_pool::allocate(packed_size(key), get_instance_id(), world_impl.taskpool()->taskpool_id,
+                                              msg_header_t::MSG_FINALIZE_ARGSTREAM_SIZE, i, 1);
         /* pack the key */
-        pos = pack(key, msg->bytes, pos);
-        msg->op_id.num_keys = 1;
-        parsec_taskpool_t *tp = world_impl.taskpool();
-        tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-        tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-        parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                          sizeof(msg_header_t) + pos);
+        pos = pack(key, msg.bytes(), pos);
+        msg->num_keys = 1;
+        this->count_msg_sent();
+        world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), " : ", key, ": finalizing stream for terminal ", i);
         }
 
-        auto hk = reinterpret_cast<parsec_key_t>(&key);
+        const detail::hashed_key_t<keyT> hkey(key);
+        const auto hk = hkey.pkey();
         task_t *task = nullptr;
         parsec_hash_table_lock_bucket(&tasks_table, hk);
         if (nullptr == (task = (task_t *)parsec_hash_table_nolock_find(&tasks_table, hk))) {
@@ -2054,6 +3219,23 @@ namespace ttg_parsec {
         // TODO: Unfriendly implementation, cannot check if stream has been finalized already
 
         // commit changes
+        if constexpr (!ttg::meta::is_void_v<std::tuple_element_t<i, input_values_full_tuple_type>>) {
+          if (async_reducers[i]) {
+            // the reduction task releases the task once it has reduced the values queued before the end of stream
+            auto *queue = reduction_queue<i>(task);
+            parsec_hash_table_unlock_bucket(&tasks_table, hk);
+            if (queue->push(new typename std::remove_pointer_t<decltype(queue)>::node{nullptr, std::nullopt}))
+              submit_reduction_task<i>(task);
+            return;
+          }
+          if (commutative_reducers[i] && nullptr != task->partials[i]) {
+            // contributions may be in flight, then the last one out completes the stream and releases the task
+            const bool release = partials<i>(task)->close() && complete_partials<i>(task);
+            parsec_hash_table_unlock_bucket(&tasks_table, hk);
+            if (release) release_task<true>(this, task);
+            return;
+          }
+        }
         task->stream[i].size = 1;
         parsec_hash_table_unlock_bucket(&tasks_table, hk);
 
@@ -2073,18 +3255,13 @@ namespace ttg_parsec {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), ": forwarding stream finalize for terminal ", i);
         }
-        using msg_t = detail::msg_t;
         auto &world_impl = world.impl();
         uint64_t pos = 0;
-        std::unique_ptr<msg_t> msg =
-            std::make_unique<msg_t>(get_instance_id(), world_impl.taskpool()->taskpool_id,
-                                    msg_header_t::MSG_FINALIZE_ARGSTREAM_SIZE, i, 1);
-        msg->op_id.num_keys = 0;
-        parsec_taskpool_t *tp = world_impl.taskpool();
-        tp->tdm.module->outgoing_message_start(tp, owner, NULL);
-        tp->tdm.module->outgoing_message_pack(tp, owner, NULL, NULL, 0);
-        parsec_ce.send_am(&parsec_ce, world_impl.parsec_ttg_tag(), owner, static_cast<void *>(msg.get()),
-                          sizeof(msg_header_t) + pos);
+        auto msg = detail::msg_pool::allocate(0, get_instance_id(), world_impl.taskpool()->taskpool_id,
+                                              msg_header_t::MSG_FINALIZE_ARGSTREAM_SIZE, i, 1);
+        msg->num_keys = 0;
+        this->count_msg_sent();
+        world_impl.send_msg(owner, msg.get(), sizeof(msg_header_t) + pos);
       } else {
         if (tracing()) {
           ttg::print(world.rank(), ":", get_name(), ": finalizing stream for terminal ", i);
@@ -2103,6 +3280,23 @@ namespace ttg_parsec {
         // TODO: Unfriendly implementation, cannot check if stream has been finalized already
 
         // commit changes
+        if constexpr (!ttg::meta::is_void_v<std::tuple_element_t<i, input_values_full_tuple_type>>) {
+          if (async_reducers[i]) {
+            // the reduction task releases the task once it has reduced the values queued before the end of stream
+            auto *queue = reduction_queue<i>(task);
+            parsec_hash_table_unlock_bucket(&tasks_table, hk);
+            if (queue->push(new typename std::remove_pointer_t<decltype(queue)>::node{nullptr, std::nullopt}))
+              submit_reduction_task<i>(task);
+            return;
+          }
+          if (commutative_reducers[i] && nullptr != task->partials[i]) {
+            // contributions may be in flight, then the last one out completes the stream and releases the task
+            const bool release = partials<i>(task)->close() && complete_partials<i>(task);
+            parsec_hash_table_unlock_bucket(&tasks_table, hk);
+            if (release) release_task<true>(this, task);
+            return;
+          }
+        }
         task->stream[i].size = 1;
         parsec_hash_table_unlock_bucket(&tasks_table, hk);
 
@@ -2150,6 +3344,14 @@ namespace ttg_parsec {
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
         input.set_callback(send_callback, move_callback, broadcast_callback, setsize_callback, finalize_callback);
+        input.set_direct_callback(
+            this,
+            [](void *op, const keyT &key, const std::decay_t<valueT> &value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, const valueT &>(key, value);
+            },
+            [](void *op, const keyT &key, std::decay_t<valueT> &&value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, valueT>(key, std::forward<valueT>(value));
+            });
       }
       //////////////////////////////////////////////////////////////////
       // case 2: nonvoid key, void value, mixed inputs
@@ -2160,6 +3362,10 @@ namespace ttg_parsec {
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op, const keyT &key) {
+          static_cast<Op *>(op)->template set_arg<i, keyT, ttg::Void>(key, ttg::Void{});
+        };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 3: nonvoid key, void value, no inputs
@@ -2170,6 +3376,8 @@ namespace ttg_parsec {
         auto setsize_callback = [this](const keyT &key, std::size_t size) { set_argstream_size<i>(key, size); };
         auto finalize_callback = [this](const keyT &key) { finalize_argstream<i>(key); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op, const keyT &key) { static_cast<Op *>(op)->template set_arg<keyT>(key); };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 4: void key, nonvoid value
@@ -2181,6 +3389,14 @@ namespace ttg_parsec {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, move_callback, {}, setsize_callback, finalize_callback);
+        input.set_direct_callback(
+            this,
+            [](void *op, const std::decay_t<valueT> &value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, const valueT &>(value);
+            },
+            [](void *op, std::decay_t<valueT> &&value) {
+              static_cast<Op *>(op)->template set_arg<i, keyT, valueT>(std::forward<valueT>(value));
+            });
       }
       //////////////////////////////////////////////////////////////////
       // case 5: void key, void value, mixed inputs
@@ -2191,6 +3407,8 @@ namespace ttg_parsec {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op) { static_cast<Op *>(op)->template set_arg<i, keyT, ttg::Void>(ttg::Void{}); };
+        input.set_direct_callback(this, send_fn, send_fn);
       }
       //////////////////////////////////////////////////////////////////
       // case 6: void key, void value, no inputs
@@ -2201,6 +3419,8 @@ namespace ttg_parsec {
         auto setsize_callback = [this](std::size_t size) { set_argstream_size<i>(size); };
         auto finalize_callback = [this]() { finalize_argstream<i>(); };
         input.set_callback(send_callback, send_callback, {}, setsize_callback, finalize_callback);
+        auto send_fn = [](void *op) { static_cast<Op *>(op)->template set_arg<keyT>(); };
+        input.set_direct_callback(this, send_fn, send_fn);
       } else
         abort();
     }
@@ -2248,9 +3468,7 @@ namespace ttg_parsec {
       if constexpr (std::is_same_v<keyT, void>) {
         return 1;
       } else {
-        keyT &ka = *(reinterpret_cast<keyT *>(a));
-        keyT &kb = *(reinterpret_cast<keyT *>(b));
-        return ka == kb;
+        return detail::hashed_key_t<keyT>::equal(a, b);
       }
     }
 
@@ -2259,10 +3477,7 @@ namespace ttg_parsec {
       if constexpr (keyT_is_Void || std::is_same_v<keyT, void>) {
         return 0;
       } else {
-        keyT &kk = *(reinterpret_cast<keyT *>(k));
-        using ttg::hash;
-        uint64_t hv = hash<decltype(kk)>{}(kk);
-        return hv;
+        return detail::hashed_key_t<keyT>::hash(k);
       }
     }
 
@@ -2271,7 +3486,7 @@ namespace ttg_parsec {
         buffer[0] = '\0';
         return buffer;
       } else {
-        keyT kk = *(reinterpret_cast<keyT *>(k));
+        const auto &kk = detail::hashed_key_t<keyT>::key(k);
         std::stringstream iss;
         iss << kk;
         memset(buffer, 0, buffer_size);
@@ -2295,6 +3510,7 @@ namespace ttg_parsec {
         op->deferred_release = nullptr;
         op->op_ptr = nullptr;
       }
+      if (nullptr != op->object_ptr) static_cast<Op *>(op->object_ptr)->count_task_completed();
       parsec_ttg_es = safe_es;
       return PARSEC_HOOK_RETURN_DONE;
     }
@@ -2310,7 +3526,7 @@ namespace ttg_parsec {
         , keymap(std::is_same<keymapT, ttg::detail::default_keymap<keyT>>::value
                      ? decltype(keymap)(ttg::detail::default_keymap<keyT>(world))
                      : decltype(keymap)(std::forward<keymapT>(keymap_)))
-        , priomap(decltype(keymap)(std::forward<priomapT>(priomap_)))
+        , priomap(decltype(priomap)(std::forward<priomapT>(priomap_)))
         , static_stream_goal() {
       // Cannot call these in base constructor since terminals not yet constructed
       if (innames.size() != std::tuple_size<input_terminals_type>::value)
@@ -2398,6 +3614,7 @@ namespace ttg_parsec {
       for (int i = 0; i < context->nb_vp; i++) {
         nbthreads += context->virtual_processes[i]->nb_cores;
       }
+      num_partials = nbthreads + 2;  // + the main and communication threads
 
       parsec_mempool_construct(
           &mempools, PARSEC_OBJ_CLASS(parsec_task_t),
@@ -2470,9 +3687,26 @@ namespace ttg_parsec {
 
     static constexpr const ttg::Runtime runtime = ttg::Runtime::PaRSEC;
 
+    /// sets the reducer of streaming input \c i
+    /// \param commutative if true, the reducer is also commutative, hence each thread may reduce the values it receives
+    ///        into its own partial result and partial results are combined once the stream is complete; this avoids
+    ///        contention on high-fan-in streams but requires the stream size to be set before values start flowing
+    ///        (or the stream to be finalized)
     template <std::size_t i, typename Reducer>
-    void set_input_reducer(Reducer &&reducer) {
+    void set_input_reducer(Reducer &&reducer, bool commutative = false) {
       std::get<i>(input_reducers) = reducer;
+      commutative_reducers[i] = commutative;
+    }
+
+    /// sets where the values of streaming input \c i are reduced
+    /// \param policy ttg::Execution::Inline (the default) reduces each value on the thread that delivers it, which
+    ///        suits cheap reducers; ttg::Execution::Async queues the values and reduces them in a separate reduction
+    ///        task, so that senders return immediately and expensive reductions overlap with other work. Like the
+    ///        commutative mode, this requires the stream size to be set before values start flowing (or the stream to
+    ///        be finalized)
+    template <std::size_t i>
+    void set_input_reducer_execution(ttg::Execution policy) {
+      async_reducers[i] = (policy == ttg::Execution::Async);
     }
 
     // Returns reference to input terminal i to facilitate connection --- terminal
@@ -2519,6 +3753,8 @@ namespace ttg_parsec {
 
     void make_executable() override {
       register_static_op_function();
+      // build the devirtualized fan-out plans of the outputs, see ttg::Out::make_executable
+      std::apply([](auto &...outputs) { (outputs.make_executable(), ...); }, output_terminals);
       OpBase::make_executable();
     }
 
@@ -2543,6 +3779,19 @@ namespace ttg_parsec {
       priomap = pm;
     }
 
+    /// thread map accessor
+    /// @return the thread map
+    const decltype(threadmap) &get_threadmap() const { return threadmap; }
+
+    /// threadmap setter
+    /// @arg tm a function that maps a key to the index of the worker thread that should execute the task, or to a
+    ///         negative value for no preference. This is a hint: the task is queued on that thread, idle threads may
+    ///         still steal it, depending on the scheduler.
+    template <typename Threadmap>
+    void set_threadmap(Threadmap &&tm) {
+      threadmap = tm;
+    }
+
     // Register the static_op function to associate it to instance_id
     void register_static_op_function(void) {
       int rank;
@@ -2550,41 +3799,31 @@ namespace ttg_parsec {
       if (tracing()) {
         ttg::print("ttg_parsec(", rank, ") Inserting into static_id_to_op_map at ", get_instance_id());
       }
-      static_set_arg_fct_call_t call = std::make_pair(&Op::static_set_arg, this);
       auto &world_impl = world.impl();
-      static_map_mutex.lock();
-      static_id_to_op_map.insert(std::make_pair(get_instance_id(), call));
-      if (delayed_unpack_actions.count(get_instance_id()) > 0) {
-        auto tp = world_impl.taskpool();
-
+      auto &slot = static_id_to_op_map.slot(get_instance_id());
+      std::vector<static_set_arg_fct_arg_t> tmp;
+      {
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        slot.call = std::make_pair(&Op::static_set_arg, this);
+        slot.registered.store(true, std::memory_order_release);
+        tmp.swap(slot.delayed);
+      }
+      if (!tmp.empty()) {
         if (tracing()) {
-          ttg::print("ttg_parsec(", rank, ") There are ", delayed_unpack_actions.count(get_instance_id()),
-                     " messages delayed with op_id ", get_instance_id());
+          ttg::print("ttg_parsec(", rank, ") There are ", tmp.size(), " messages delayed with op_id ",
+                     get_instance_id());
         }
 
-        auto se = delayed_unpack_actions.equal_range(get_instance_id());
-        std::vector<static_set_arg_fct_arg_t> tmp;
-        for (auto it = se.first; it != se.second;) {
-          assert(it->first == get_instance_id());
-          tmp.push_back(it->second);
-          it = delayed_unpack_actions.erase(it);
-        }
-        static_map_mutex.unlock();
-
         for (auto it : tmp) {
           if (tracing()) {
             ttg::print("ttg_parsec(", rank, ") Unpacking delayed message (", ", ", get_instance_id(), ", ",
                        std::get<1>(it), ", ", std::get<2>(it), ")");
           }
-          int rc = detail::static_unpack_msg(&parsec_ce, world_impl.parsec_ttg_tag(), std::get<1>(it), std::get<2>(it),
-                                             std::get<0>(it), NULL);
-          assert(rc == 0);
+          /* a batch of coalesced messages is delayed again if it holds messages to other unregistered ops */
+          detail::static_unpack_msg(&parsec_ce, world_impl.parsec_ttg_tag(), std::get<1>(it), std::get<2>(it),
+                                    std::get<0>(it), NULL);
           free(std::get<1>(it));
         }
-
-        tmp.clear();
-      } else {
-        static_map_mutex.unlock();
       }
     }
   };
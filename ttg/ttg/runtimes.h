@@ -20,7 +20,9 @@ namespace ttg {
   template <>
   struct runtime_traits<Runtime::PaRSEC> {
     static constexpr const bool supports_streaming_terminal = true;
-    static constexpr const bool supports_async_reduction = false;
+    static constexpr const bool supports_async_reduction = true;
+    static constexpr const bool supports_threadmap = true;
+    static constexpr const bool supports_key_migration = false;
     using hash_t = unsigned long;  // must be same as parsec_key_t
     constexpr static ExecutionSpace execution_spaces[] = {ExecutionSpace::CUDA, ExecutionSpace::Host};
     constexpr static std::size_t num_execution_spaces = sizeof(execution_spaces) / sizeof(ExecutionSpace);
@@ -30,6 +32,8 @@ namespace ttg {
   struct runtime_traits<Runtime::MADWorld> {
     static constexpr const bool supports_streaming_terminal = true;
     static constexpr const bool supports_async_reduction = true;
+    static constexpr const bool supports_threadmap = false;
+    static constexpr const bool supports_key_migration = true;
     using hash_t = uint64_t;
     constexpr static ExecutionSpace execution_spaces[] = {ExecutionSpace::Host};
     constexpr static std::size_t num_execution_spaces = sizeof(execution_spaces) / sizeof(ExecutionSpace);
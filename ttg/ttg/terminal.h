@@ -30,6 +30,8 @@ namespace ttg {
     using broadcast_callback_type = meta::detail::broadcast_callback_t<keyT, std::decay_t<valueT>>;
     using setsize_callback_type = meta::detail::setsize_callback_t<keyT>;
     using finalize_callback_type = meta::detail::finalize_callback_t<keyT>;
+    using send_fn_type = meta::detail::send_fn_t<keyT, std::decay_t<valueT>>;
+    using move_fn_type = meta::detail::move_fn_t<keyT, std::decay_t<valueT>>;
     static constexpr bool is_an_input_terminal = true;
 
    private:
@@ -39,6 +41,14 @@ namespace ttg {
     setsize_callback_type setsize_callback;
     finalize_callback_type finalize_callback;
 
+    // devirtualized send/move entry points, see set_direct_callback
+    void *target = nullptr;
+    send_fn_type send_fn = nullptr;
+    move_fn_type move_fn = nullptr;
+
+    template <typename Key, typename Value>
+    friend class Out;
+
     // No moving, copying, assigning permitted
     In(In &&other) = delete;
     In(const In &other) = delete;
@@ -61,11 +71,24 @@ namespace ttg {
       this->broadcast_callback = bcast_callback;
       this->setsize_callback = setsize_callback;
       this->finalize_callback = finalize_callback;
+      // the direct entry points, if any, would take precedence over the new callbacks
+      set_direct_callback(nullptr, nullptr, nullptr);
+    }
+
+    /// sets the devirtualized entry points of sends and moves, which take precedence over the send and move callbacks:
+    /// each is a plain function called with \p target as its first argument, typically a captureless lambda that
+    /// casts \p target back to the op that owns this terminal, so that a send reaches the op without type erasure.
+    /// Out terminals collect them into their fan-out plan, see Out::make_executable
+    void set_direct_callback(void *target, send_fn_type send_fn, move_fn_type move_fn) {
+      this->target = target;
+      this->send_fn = send_fn;
+      this->move_fn = move_fn;
     }
 
     template <typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value>,void>
     send(const Key &key, const Value &value) {
+      if (send_fn) return send_fn(target, key, value);
       if (!send_callback) throw std::runtime_error("send callback not initialized");
       send_callback(key, value);
     }
@@ -73,6 +96,7 @@ namespace ttg {
     template <typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value> && std::is_same_v<Value,std::remove_reference_t<Value>>,void>
     send(const Key &key, Value &&value) {
+      if (move_fn) return move_fn(target, key, std::forward<valueT>(value));
       if (!move_callback) throw std::runtime_error("move callback not initialized");
       move_callback(key, std::forward<valueT>(value));
     }
@@ -80,6 +104,7 @@ namespace ttg {
     template <typename Key = keyT>
     std::enable_if_t<!meta::is_void_v<Key>,void>
     sendk(const Key &key) {
+      if (send_fn) return send_fn(target, key);
       if (!send_callback) throw std::runtime_error("send callback not initialized");
       send_callback(key);
     }
@@ -87,6 +112,7 @@ namespace ttg {
     template <typename Value = valueT>
     std::enable_if_t<!meta::is_void_v<Value>,void>
     sendv(const Value &value) {
+      if (send_fn) return send_fn(target, value);
       if (!send_callback) throw std::runtime_error("send callback not initialized");
       send_callback(value);
     }
@@ -94,11 +120,13 @@ namespace ttg {
     template <typename Value = valueT>
     std::enable_if_t<!meta::is_void_v<Value> && std::is_same_v<Value,std::remove_reference_t<Value>>,void>
     sendv(Value &&value) {
+      if (move_fn) return move_fn(target, std::forward<valueT>(value));
       if (!move_callback) throw std::runtime_error("move callback not initialized");
       move_callback(std::forward<valueT>(value));
     }
 
     void send() {
+      if (send_fn) return send_fn(target);
       if (!send_callback) throw std::runtime_error("send callback not initialized");
       send_callback();
     }
@@ -187,6 +215,51 @@ namespace ttg {
     static constexpr bool is_an_output_terminal = true;
 
    private:
+    using consumer_type = In<keyT, valueT>;
+    using reader_type = In<keyT, std::add_const_t<valueT>>;
+
+    // the successors, split by terminal type when connected, so that sends do not need to query the type of each
+    // successor
+    std::vector<consumer_type *> consumers_;
+    std::vector<reader_type *> readers_;
+
+    // the devirtualized fan-out plan, see make_executable(): the direct entry points of the readers, followed by
+    // those of the consumers
+    struct plan_entry {
+      void *target;
+      typename consumer_type::send_fn_type send_fn;
+      typename consumer_type::move_fn_type move_fn;
+    };
+    std::vector<plan_entry> plan_;
+    std::size_t plan_nreaders_ = 0;
+    bool planned_ = false;
+
+    /// applies \p f to every successor, as a pointer to its concrete type
+    template <typename F>
+    void for_each_successor(F &&f) {
+      for (auto &&successor : readers_) f(successor);
+      for (auto &&successor : consumers_) f(successor);
+    }
+
+    /// calls the send entry point of every successor with \p args , through the plan if it was built
+    template <typename... Args>
+    void send_to_successors(const Args &...args) {
+      if (planned_) {
+        for (auto &&entry : plan_) entry.send_fn(entry.target, args...);
+      } else {
+        for_each_successor([&](auto *successor) {
+          if constexpr (sizeof...(Args) == 0)
+            successor->send();
+          else if constexpr (meta::is_void_v<valueT>)
+            successor->sendk(args...);
+          else if constexpr (meta::is_void_v<keyT>)
+            successor->sendv(args...);
+          else
+            successor->send(args...);
+        });
+      }
+    }
+
     // No moving, copying, assigning permitted
     Out(Out &&other) = delete;
     Out(const Out &other) = delete;
@@ -217,7 +290,33 @@ namespace ttg {
         print(rank(), ": connected Out<> ", get_name(), "(ptr=", this, ") to In<> ", in->get_name(), "(ptr=", in, ")");
       }
 #endif
+      if (in->get_type() == TerminalBase::Type::Read)
+        readers_.push_back(static_cast<reader_type *>(in));
+      else
+        consumers_.push_back(static_cast<consumer_type *>(in));
       this->connect_base(in);
+      // sends fall back to the successor lists until the plan is rebuilt
+      planned_ = false;
+    }
+
+    /// builds the devirtualized fan-out plan from the direct entry points of the successors (see
+    /// In::set_direct_callback); called when the op that owns this terminal is made executable. Sends then call the
+    /// op of each successor through a plain function pointer, with no type erasure or per-successor branching. If
+    /// some successor provides no direct entry points, e.g. a terminal with user callbacks, no plan is built and
+    /// sends go through the terminals of the successors.
+    void make_executable() {
+      planned_ = false;
+      plan_.clear();
+      for (auto &&successor : readers_) {
+        if (!successor->send_fn) return;
+        plan_.push_back({successor->target, successor->send_fn, nullptr});
+      }
+      plan_nreaders_ = plan_.size();
+      for (auto &&successor : consumers_) {
+        if (!successor->send_fn || !successor->move_fn) return;
+        plan_.push_back({successor->target, successor->send_fn, successor->move_fn});
+      }
+      planned_ = true;
     }
 
     auto nsuccessors() const {
@@ -229,38 +328,17 @@ namespace ttg {
 
     template<typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value>,void> send(const Key &key, const Value &value) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->send(key, value);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->send(key, value);
-        }
-      }
+      send_to_successors(key, value);
     }
 
     template<typename Key = keyT, typename Value = valueT>
     std::enable_if_t<!meta::is_void_v<Key> && meta::is_void_v<Value>,void> sendk(const Key &key) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->sendk(key);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->sendk(key);
-        }
-      }
+      send_to_successors(key);
     }
 
     template<typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_void_v<Key> && !meta::is_void_v<Value>,void> sendv(const Value &value) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->sendv(value);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->sendv(value);
-        }
-      }
+      send_to_successors(value);
     }
 
     template<typename Key = keyT, typename Value = valueT>
@@ -268,50 +346,34 @@ namespace ttg {
       if (tracing()) {
         print(rank(), ": in ", get_name(), "(ptr=", this, ") Out<>::send: #successors=", successors().size());
       }
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->send();
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->send();
-        }
-        else {
-          throw std::logic_error("Out<>: invalid successor type");
-        }
+      for_each_successor([&](auto *successor) {
+        successor->send();
         if (tracing()) {
           print("Out<> ", get_name(), "(ptr=", this, ") send to In<> ", successor->get_name(), "(ptr=", successor, ")");
         }
-      }
+      });
     }
 
     template <typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value> && std::is_same_v<Value,std::remove_reference_t<Value>>,void>
     send(const Key &key, Value &&value) {
-      std::size_t N = successors().size();
-      // find the first terminal that can consume the value
-      std::size_t move_terminal = N - 1;
-      for (std::size_t i = 0; i != N; ++i) {
-        if (successors().at(i)->get_type() == TerminalBase::Type::Consume) {
-          move_terminal = i;
-          break;
+      if (planned_) {
+        const std::size_t N = plan_.size();
+        // send copies to every successor except the last consumer, which gets the value moved into
+        if (N > plan_nreaders_) {
+          for (std::size_t i = 0; i != N - 1; ++i) plan_[i].send_fn(plan_[i].target, key, value);
+          plan_[N - 1].move_fn(plan_[N - 1].target, key, std::forward<Value>(value));
+        } else {
+          for (auto &&entry : plan_) entry.send_fn(entry.target, key, value);
         }
+        return;
       }
+      for (auto &&successor : readers_) successor->send(key, value);
+      const std::size_t N = consumers_.size();
       if (N > 0) {
-        // send copies to every terminal except the one we will move the results to
-        for (std::size_t i = 0; i != N; ++i) {
-          if (i != move_terminal) {
-            TerminalBase *successor = successors().at(i);
-            if (successor->get_type() == TerminalBase::Type::Read) {
-              static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->send(key, value);
-            } else if (successor->get_type() == TerminalBase::Type::Consume) {
-              static_cast<In<keyT, valueT> *>(successor)->send(key, value);
-            }
-          }
-        }
-        {
-          TerminalBase *successor = successors().at(move_terminal);
-          static_cast<In<keyT, valueT> *>(successor)->send(key, std::forward<Value>(value));
-        }
+        // send copies to every consumer except the last one, which gets the value moved into
+        for (std::size_t i = 0; i != N - 1; ++i) consumers_[i]->send(key, value);
+        consumers_[N - 1]->send(key, std::forward<Value>(value));
       }
     }
 
@@ -320,14 +382,7 @@ namespace ttg {
     template<typename rangeT, typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value>,void>
     broadcast(const rangeT &keylist, const Value &value) {  // NO MOVE YET
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->broadcast(keylist, value);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->broadcast(keylist, value);
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->broadcast(keylist, value); });
     }
 
     // An optimized implementation will need a separate callback for broadcast
@@ -335,66 +390,31 @@ namespace ttg {
     template<typename rangeT, typename Key = keyT, typename Value = valueT>
     std::enable_if_t<meta::is_none_void_v<Key,Value>,void>
     broadcast(const rangeT &keylist, std::shared_ptr<const Value> &value_ptr) {  // NO MOVE YET
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->broadcast(keylist, value_ptr);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->broadcast(keylist, value_ptr);
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->broadcast(keylist, value_ptr); });
     }
 
     template<typename Key = keyT>
     std::enable_if_t<!meta::is_void_v<Key>,void>
     set_size(const Key &key, std::size_t size) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->set_size(key, size);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->set_size(key, size);
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->set_size(key, size); });
     }
 
     template<typename Key = keyT>
     std::enable_if_t<meta::is_void_v<Key>,void>
     set_size(std::size_t size) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->set_size(size);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->set_size(size);
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->set_size(size); });
     }
 
     template<typename Key = keyT>
     std::enable_if_t<!meta::is_void_v<Key>,void>
     finalize(const Key &key) {
-      for (auto && successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->finalize(key);
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->finalize(key);
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->finalize(key); });
     }
 
     template<typename Key = keyT>
     std::enable_if_t<meta::is_void_v<Key>,void>
     finalize() {
-      for (auto successor : successors()) {
-        assert(successor->get_type() != TerminalBase::Type::Write);
-        if (successor->get_type() == TerminalBase::Type::Read) {
-          static_cast<In<keyT, std::add_const_t<valueT>> *>(successor)->finalize();
-        } else if (successor->get_type() == TerminalBase::Type::Consume) {
-          static_cast<In<keyT, valueT> *>(successor)->finalize();
-        }
-      }
+      for_each_successor([&](auto *successor) { successor->finalize(); });
     }
 
     Type get_type() const override { return TerminalBase::Type::Write; }
@@ -0,0 +1,163 @@
+#ifndef TTG_UTIL_CRITICAL_PATH_H
+#define TTG_UTIL_CRITICAL_PATH_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ttg/util/hash.h"
+
+namespace ttg {
+
+  /// Derives task priorities from the critical path of a task graph
+
+  /// The graph is described by the cost of the task with a given key and the keys of its successors, i.e. the tasks
+  /// that consume its results. The priority of a task is its <em>bottom level</em>: the cost of the most expensive
+  /// path from the task to the end of the graph, including the task itself. Executing tasks in the order of
+  /// decreasing bottom level keeps the critical path busy, which is what hand-written priority maps usually
+  /// approximate (e.g. by the length of the remaining chain of updates of a tile).
+  ///
+  /// Bottom levels are computed on demand and memoized, hence each task is visited once no matter how many
+  /// priority maps query it; call clear() to drop the memoized values once a graph has been executed.
+  /// Tasks of several ops can be ordered consistently by describing them with a common \c Key type
+  /// (e.g. a variant or a tagged tuple) and installing priomap() with a key conversion on each op.
+  /// \tparam Key the key type; must be hashable by ttg::hash and comparable with \c ==
+  template <typename Key>
+  class critical_path {
+   public:
+    using cost_fn = std::function<double(const Key &)>;
+    using successors_fn = std::function<std::vector<Key>(const Key &)>;
+
+    /// \param cost returns the (estimated) cost of the task with a given key, in arbitrary units
+    /// \param successors returns the keys of the successors of the task with a given key
+    /// \param scale priorities are the bottom levels multiplied by \p scale and rounded to integers
+    critical_path(cost_fn cost, successors_fn successors, double scale = 1.0)
+        : impl_(std::make_shared<impl_t>(std::move(cost), std::move(successors), scale)) {}
+
+    /// @return the cost of the most expensive path from the task with key \p key to the end of the graph
+    /// @throw std::logic_error if the graph reachable from \p key has a cycle
+    double bottom_level(const Key &key) const { return impl_->bottom_level(key); }
+
+    /// @return the priority of the task with key \p key , i.e. its scaled bottom level clamped to the range of \c int
+    int priority(const Key &key) const {
+      const double p = std::round(bottom_level(key) * impl_->scale);
+      return static_cast<int>(std::clamp(p, 0.0, static_cast<double>(std::numeric_limits<int>::max())));
+    }
+
+    /// @return a priority map, to be passed to the \c set_priomap method of an op whose keys are of type \c Key
+    auto priomap() const {
+      return [impl = impl_](const Key &key) { return critical_path(impl).priority(key); };
+    }
+
+    /// @return a priority map for an op with keys of type \c OpKey , converted to \c Key by \p to_key
+    template <typename OpKey, typename ToKey>
+    auto priomap(ToKey &&to_key) const {
+      return [impl = impl_, to_key = std::forward<ToKey>(to_key)](const OpKey &key) {
+        return critical_path(impl).priority(to_key(key));
+      };
+    }
+
+    /// drops the memoized bottom levels
+    void clear() { impl_->clear(); }
+
+   private:
+    struct impl_t {
+      cost_fn cost;
+      successors_fn successors;
+      double scale;
+
+      /// the memoized levels are sharded by key hash, so that concurrent priority maps rarely contend
+      struct alignas(64) shard_t {
+        std::mutex mtx;
+        std::unordered_map<Key, double, ttg::hash<Key>> levels;
+      };
+      static constexpr std::size_t nshards = 64;
+      std::array<shard_t, nshards> shards;
+
+      impl_t(cost_fn cost, successors_fn successors, double scale)
+          : cost(std::move(cost)), successors(std::move(successors)), scale(scale) {}
+
+      shard_t &shard(const Key &key) { return shards[ttg::hash<Key>{}(key) % nshards]; }
+
+      bool find(const Key &key, double &level) {
+        auto &s = shard(key);
+        std::scoped_lock lock(s.mtx);
+        auto it = s.levels.find(key);
+        if (it == s.levels.end()) return false;
+        level = it->second;
+        return true;
+      }
+
+      void insert(const Key &key, double level) {
+        auto &s = shard(key);
+        std::scoped_lock lock(s.mtx);
+        s.levels.emplace(key, level);
+      }
+
+      void clear() {
+        for (auto &s : shards) {
+          std::scoped_lock lock(s.mtx);
+          s.levels.clear();
+        }
+      }
+
+      /// N.B. depth-first traversal with an explicit stack, since chains of tasks can be long; concurrent callers
+      /// may compute the same levels, the first one to finish memoizes them
+      double bottom_level(const Key &root) {
+        double level;
+        if (find(root, level)) return level;
+
+        struct frame_t {
+          Key key;
+          std::vector<Key> successors;
+          std::size_t next = 0;  // the next successor to visit
+          double max_successor_level = 0;
+        };
+        std::vector<frame_t> stack;
+        std::unordered_set<Key, ttg::hash<Key>> on_stack;
+        stack.push_back(frame_t{root, successors(root)});
+        on_stack.insert(root);
+        while (true) {
+          auto &frame = stack.back();
+          if (frame.next != frame.successors.size()) {
+            const Key &successor = frame.successors[frame.next];
+            if (find(successor, level)) {
+              frame.max_successor_level = std::max(frame.max_successor_level, level);
+              ++frame.next;
+            } else {
+              if (!on_stack.insert(successor).second)
+                throw std::logic_error("ttg::critical_path: the task graph has a cycle");
+              stack.push_back(frame_t{successor, successors(successor)});  // N.B. invalidates frame
+            }
+            continue;
+          }
+          level = cost(frame.key) + frame.max_successor_level;
+          insert(frame.key, level);
+          on_stack.erase(frame.key);
+          stack.pop_back();
+          if (stack.empty()) return level;
+          auto &parent = stack.back();
+          parent.max_successor_level = std::max(parent.max_successor_level, level);
+          ++parent.next;
+        }
+      }
+    };
+
+    explicit critical_path(std::shared_ptr<impl_t> impl) : impl_(std::move(impl)) {}
+
+    std::shared_ptr<impl_t> impl_;
+  };
+
+}  // namespace ttg
+
+#endif  // TTG_UTIL_CRITICAL_PATH_H
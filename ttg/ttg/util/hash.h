@@ -1,8 +1,13 @@
 #ifndef TTG_TTG_UTIL_HASH_H
 #define TTG_TTG_UTIL_HASH_H
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "ttg/util/void.h"
 
@@ -32,6 +37,64 @@ namespace ttg {
       /// @return the initial hash value
       static result_type initial_value() { return offset_basis; }
     };
+
+    /// @brief word-wise hasher
+    /// Consumes its input 8 bytes at a time and finalizes with the MurmurHash3 64-bit mixer, hence is
+    /// much cheaper than FNVhasher for anything longer than a couple of bytes.
+    class WordHasher {
+      using result_type = std::size_t;
+      static constexpr std::uint64_t seed = 0x9e3779b97f4a7c15ul;
+      static constexpr std::uint64_t multiplier = 0xc6a4a7935bd1e995ul;
+      std::uint64_t value_ = seed;
+
+      static constexpr std::uint64_t rotl(std::uint64_t x, int r) noexcept { return (x << r) | (x >> (64 - r)); }
+
+     public:
+      /// @return \p x with all of its bits avalanched
+      static constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdul;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ul;
+        x ^= x >> 33;
+        return x;
+      }
+
+      /// Updates the hash with one 64-bit word
+      /// @param[in] word the input value
+      void update(std::uint64_t word) noexcept { value_ = (rotl(value_, 23) ^ word) * multiplier; }
+
+      /// Updates the hash with an additional n bytes; the trailing partial word is zero-padded
+      void update(size_t n, const std::byte* bytes) noexcept {
+        size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t)) {
+          std::uint64_t word;
+          std::memcpy(&word, bytes + i, sizeof(std::uint64_t));
+          update(word);
+        }
+        if (i < n) {
+          std::uint64_t word = 0;
+          std::memcpy(&word, bytes + i, n - i);
+          update(word);
+        }
+      }
+
+      /// @return the value of the hash of the stream
+      result_type value() const noexcept { return mix(value_); }
+    };
+
+    /// true if objects of type T can be hashed by their object representation, i.e. T is trivially copyable
+    /// and has no padding bits (hence equal objects are guaranteed to have equal bytes)
+    template <typename T>
+    constexpr bool is_bytewise_hashable_v =
+        std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>;
+
+    template <typename T>
+    std::uint64_t hash_word(const T& field);
+
+    /// hashes a sequence of fields
+    template <typename... Ts>
+    std::size_t hash_fields(const Ts&... fields);
   }  // namespace detail
 
   /// place for overloading/instantiating hash and other functionality
@@ -56,13 +119,49 @@ namespace ttg {
       auto operator()() const { return detail::FNVhasher::initial_value(); }
     };
 
-    /// default implementation uses the bitwise hasher FNVhasher
+    /// instantiation of hash for std::pair hashes the elements one by one, hence does not see padding
+    template <typename T1, typename T2>
+    struct hash<std::pair<T1, T2>, void> {
+      auto operator()(const std::pair<T1, T2>& t) const { return detail::hash_fields(t.first, t.second); }
+    };
+
+    /// instantiation of hash for std::tuple hashes the elements one by one, hence does not see padding
+    template <typename... Ts>
+    struct hash<std::tuple<Ts...>, void> {
+      auto operator()(const std::tuple<Ts...>& t) const {
+        return std::apply([](const auto&... elems) { return detail::hash_fields(elems...); }, t);
+      }
+    };
+
+    /// instantiation of hash for std::array hashes the element storage directly if it has no padding,
+    /// otherwise hashes the elements one by one
+    template <typename T, std::size_t N>
+    struct hash<std::array<T, N>, void> {
+      auto operator()(const std::array<T, N>& t) const {
+        detail::WordHasher hasher;
+        if constexpr (detail::is_bytewise_hashable_v<T>) {
+          hasher.update(sizeof(T) * N, reinterpret_cast<const std::byte*>(t.data()));
+        } else {
+          for (const auto& elem : t) hasher.update(detail::hash_word(elem));
+        }
+        return hasher.value();
+      }
+    };
+
+    /// default implementation uses the word-wise hasher WordHasher for trivially copyable types without padding,
+    /// and the bitwise hasher FNVhasher otherwise
     template <typename T, typename Enabler>
     struct hash {
       auto operator()(const T& t) const {
-        detail::FNVhasher hasher;
-        hasher.update(sizeof(T), reinterpret_cast<const std::byte*>(&t));
-        return hasher.value();
+        if constexpr (detail::is_bytewise_hashable_v<T>) {
+          detail::WordHasher hasher;
+          hasher.update(sizeof(T), reinterpret_cast<const std::byte*>(&t));
+          return hasher.value();
+        } else {
+          detail::FNVhasher hasher;
+          hasher.update(sizeof(T), reinterpret_cast<const std::byte*>(&t));
+          return hasher.value();
+        }
       }
     };
 
@@ -70,6 +169,27 @@ namespace ttg {
 
   using namespace ttg::overload;
 
+  namespace detail {
+    /// @return the word that represents \p field in a WordHasher stream: the value itself for integers and enums
+    /// (the stream is mixed anyway), else its hash
+    template <typename T>
+    std::uint64_t hash_word(const T& field) {
+      if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, &field, sizeof(T));
+        return word;
+      } else
+        return ttg::hash<T>{}(field);
+    }
+
+    template <typename... Ts>
+    std::size_t hash_fields(const Ts&... fields) {
+      WordHasher hasher;
+      (hasher.update(hash_word(fields)), ...);
+      return hasher.value();
+    }
+  }  // namespace detail
+
   namespace meta {
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // has_ttg_hash_specialization_v<T> evaluates to true if ttg::hash<T> is defined
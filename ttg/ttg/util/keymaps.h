@@ -0,0 +1,330 @@
+#ifndef TTG_UTIL_KEYMAPS_H
+#define TTG_UTIL_KEYMAPS_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ttg {
+
+  // Keymaps that distribute index spaces over processes the way distributed dense and block-sparse linear algebra
+  // does. The default keymap hashes keys, which balances load but scatters tiles that exchange data among all ranks;
+  // the maps below keep such tiles on the same row/column of a process grid, hence the consumers of a tile are
+  // found on few ranks and broadcasts reach fewer of them.
+  // Maps take (non-negative) integer indices; use project_keymap to install them on ops with multi-index keys.
+  // tree_keymap does the same for the boxes of refinement trees, keeping parents with their children.
+
+  namespace detail {
+    template <typename T, typename Enabler = void>
+    struct is_tuple_like : std::false_type {};
+    template <typename T>
+    struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {};
+  }  // namespace detail
+
+  /// the order in which processes are laid out on a process grid
+  enum class grid_order {
+    row_major,    //!< process (p,q) of a PxQ grid is rank p*Q+q (as in PaRSEC's two_dim_block_cyclic)
+    column_major  //!< process (p,q) of a PxQ grid is rank q*P+p
+  };
+
+  /// Block-cyclic distribution of a 1-D index space: blocks of \c block consecutive indices are dealt round-robin
+  /// to \c nranks processes, starting at process \c offset
+  class block_cyclic_1d {
+   public:
+    /// \param nranks the number of processes
+    /// \param block the number of consecutive indices in a block; 1 gives a cyclic distribution
+    /// \param offset the process that owns the first block
+    explicit block_cyclic_1d(int nranks, std::int64_t block = 1, int offset = 0)
+        : nranks_(nranks), block_(block), offset_(offset) {
+      assert(nranks_ > 0 && block_ > 0 && offset_ >= 0 && offset_ < nranks_);
+    }
+
+    /// @return the process that owns index \p i
+    int operator()(std::int64_t i) const {
+      assert(i >= 0);
+      return static_cast<int>((i / block_ + offset_) % nranks_);
+    }
+
+    int nranks() const { return nranks_; }
+
+   private:
+    int nranks_;
+    std::int64_t block_;
+    int offset_;
+  };
+
+  /// Block-cyclic distribution of a 2-D index space over a PxQ process grid: the block of row \c i and column \c j
+  /// is owned by process (p,q) = ((i/mb)%P, (j/nb)%Q), as in ScaLAPACK and PaRSEC. The consumers of a tile of
+  /// a row (column) panel are found on a single row (column) of the grid.
+  class block_cyclic_2d {
+   public:
+    /// \param P the number of rows of the process grid
+    /// \param Q the number of columns of the process grid
+    /// \param mb the number of consecutive row indices in a block
+    /// \param nb the number of consecutive column indices in a block
+    /// \param order the layout of ranks on the grid
+    block_cyclic_2d(int P, int Q, std::int64_t mb = 1, std::int64_t nb = 1, grid_order order = grid_order::row_major)
+        : P_(P), Q_(Q), mb_(mb), nb_(nb), order_(order) {
+      assert(P_ > 0 && Q_ > 0 && mb_ > 0 && nb_ > 0);
+    }
+
+    /// @return the process that owns index (\p i , \p j )
+    int operator()(std::int64_t i, std::int64_t j) const {
+      assert(i >= 0 && j >= 0);
+      return rank(static_cast<int>((i / mb_) % P_), static_cast<int>((j / nb_) % Q_));
+    }
+
+    /// @return the rank of process (\p p , \p q ) of the grid
+    int rank(int p, int q) const { return order_ == grid_order::row_major ? p * Q_ + q : q * P_ + p; }
+
+    int P() const { return P_; }
+    int Q() const { return Q_; }
+    int nranks() const { return P_ * Q_; }
+
+   private:
+    int P_, Q_;
+    std::int64_t mb_, nb_;
+    grid_order order_;
+  };
+
+  /// Block-cyclic distribution of a 3-D index space over a PxQxR process grid; process (p,q,r) is rank
+  /// (p*Q+q)*R+r for grid_order::row_major and (r*Q+q)*P+p for grid_order::column_major
+  class block_cyclic_3d {
+   public:
+    /// \param P,Q,R the extents of the process grid
+    /// \param mb,nb,kb the number of consecutive indices in a block along each dimension
+    /// \param order the layout of ranks on the grid
+    block_cyclic_3d(int P, int Q, int R, std::int64_t mb = 1, std::int64_t nb = 1, std::int64_t kb = 1,
+                    grid_order order = grid_order::row_major)
+        : P_(P), Q_(Q), R_(R), mb_(mb), nb_(nb), kb_(kb), order_(order) {
+      assert(P_ > 0 && Q_ > 0 && R_ > 0 && mb_ > 0 && nb_ > 0 && kb_ > 0);
+    }
+
+    /// @return the process that owns index (\p i , \p j , \p k )
+    int operator()(std::int64_t i, std::int64_t j, std::int64_t k) const {
+      assert(i >= 0 && j >= 0 && k >= 0);
+      const int p = static_cast<int>((i / mb_) % P_);
+      const int q = static_cast<int>((j / nb_) % Q_);
+      const int r = static_cast<int>((k / kb_) % R_);
+      return order_ == grid_order::row_major ? (p * Q_ + q) * R_ + r : (r * Q_ + q) * P_ + p;
+    }
+
+    int nranks() const { return P_ * Q_ * R_; }
+
+   private:
+    int P_, Q_, R_;
+    std::int64_t mb_, nb_, kb_;
+    grid_order order_;
+  };
+
+  /// Diagonal-aware 2-D block-cyclic distribution for triangular and symmetric factorizations (Cholesky, LDLt, ...)
+  ///
+  /// With a plain block-cyclic distribution the diagonal blocks, whose factorization is on the critical path, are
+  /// owned by gcd-many processes of the grid only (e.g. P of the PxP processes of a square grid). This map keeps
+  /// the off-diagonal blocks block-cyclic and deals the diagonal blocks round-robin to all processes instead; the
+  /// owner of a diagonal block broadcasts it to a single column of the grid, as before.
+  /// If \c fold is set, the blocks of the upper triangle are owned by the owner of the transposed block of the lower
+  /// triangle, so that the tasks of a symmetric matrix that name either triangle are colocated.
+  class diagonal_block_cyclic_2d {
+   public:
+    /// \param P the number of rows of the process grid
+    /// \param Q the number of columns of the process grid
+    /// \param mb,nb the number of consecutive row/column indices in a block; must be equal if \p fold is set
+    /// \param fold whether to map block (i,j), i<j, onto block (j,i)
+    /// \param order the layout of ranks on the grid
+    diagonal_block_cyclic_2d(int P, int Q, std::int64_t mb = 1, std::int64_t nb = 1, bool fold = false,
+                             grid_order order = grid_order::row_major)
+        : bc_(P, Q, mb, nb, order), mb_(mb), nb_(nb), fold_(fold) {
+      assert(!fold_ || mb_ == nb_);
+    }
+
+    /// @return the process that owns index (\p i , \p j )
+    int operator()(std::int64_t i, std::int64_t j) const {
+      if (fold_ && i < j) std::swap(i, j);
+      const std::int64_t bi = i / mb_;
+      const std::int64_t bj = j / nb_;
+      if (bi == bj) return static_cast<int>(bi % bc_.nranks());
+      return bc_(i, j);
+    }
+
+    int nranks() const { return bc_.nranks(); }
+
+   private:
+    block_cyclic_2d bc_;
+    std::int64_t mb_, nb_;
+    bool fold_;
+  };
+
+  /// Block distribution of the integer range [0,n): process r owns the contiguous range [begin(r),end(r)), the
+  /// ranges differ in size by at most 1. Suits keys whose neighbors exchange data, e.g. 1-D stencils and chains.
+  class range_block {
+   public:
+    /// \param n the number of indices
+    /// \param nranks the number of processes
+    range_block(std::int64_t n, int nranks)
+        : n_(n), nranks_(nranks), size_(n / nranks), nlarge_(static_cast<int>(n % nranks)) {
+      assert(n_ >= 0 && nranks_ > 0);
+    }
+
+    /// @return the process that owns index \p i
+    int operator()(std::int64_t i) const {
+      assert(i >= 0 && i < n_);
+      const std::int64_t large_end = nlarge_ * (size_ + 1);  // the first nlarge_ ranges hold size_+1 indices
+      if (i < large_end) return static_cast<int>(i / (size_ + 1));
+      return static_cast<int>(nlarge_ + (i - large_end) / size_);
+    }
+
+    /// @return the first index owned by process \p r
+    std::int64_t begin(int r) const { return r * size_ + std::min(r, nlarge_); }
+    /// @return the index past the last index owned by process \p r
+    std::int64_t end(int r) const { return begin(r + 1); }
+
+    int nranks() const { return nranks_; }
+
+   private:
+    std::int64_t n_;
+    int nranks_;
+    std::int64_t size_;
+    int nlarge_;
+  };
+
+  /// space-filling curves that order the boxes of a level of a \c 2^NDIM -ary refinement tree
+  enum class space_filling_curve {
+    morton,  //!< Z-order: interleaves the bits of the translations; cheap, but has jumps between quadrants
+    hilbert  //!< consecutive boxes are face neighbors, hence ranges of the curve have smaller surfaces
+  };
+
+  namespace detail {
+
+    /// @return the index of box \p l of a grid of \c 2^nbits boxes per dimension along the Morton curve;
+    /// the bits of \c l[0] are the most significant of each group of \c NDIM bits
+    template <std::size_t NDIM>
+    std::uint64_t morton_index(const std::array<std::uint64_t, NDIM> &l, int nbits) {
+      std::uint64_t index = 0;
+      for (int b = nbits - 1; b >= 0; --b)
+        for (std::size_t d = 0; d != NDIM; ++d) index = (index << 1) | ((l[d] >> b) & 1);
+      return index;
+    }
+
+    /// @return the index of box \p l of a grid of \c 2^nbits boxes per dimension along the Hilbert curve
+    /// \note uses the transposition algorithm of J. Skilling, AIP Conf. Proc. 707, 381 (2004)
+    template <std::size_t NDIM>
+    std::uint64_t hilbert_index(std::array<std::uint64_t, NDIM> x, int nbits) {
+      if constexpr (NDIM == 1) {
+        return x[0];
+      } else {
+        if (nbits == 0) return 0;
+        const std::uint64_t M = std::uint64_t(1) << (nbits - 1);
+        for (std::uint64_t Q = M; Q > 1; Q >>= 1) {  // inverse undo
+          const std::uint64_t P = Q - 1;
+          for (std::size_t i = 0; i != NDIM; ++i) {
+            if (x[i] & Q) {
+              x[0] ^= P;
+            } else {
+              const std::uint64_t t = (x[0] ^ x[i]) & P;
+              x[0] ^= t;
+              x[i] ^= t;
+            }
+          }
+        }
+        for (std::size_t i = 1; i != NDIM; ++i) x[i] ^= x[i - 1];  // Gray encode
+        std::uint64_t t = 0;
+        for (std::uint64_t Q = M; Q > 1; Q >>= 1)
+          if (x[NDIM - 1] & Q) t ^= Q - 1;
+        for (std::size_t i = 0; i != NDIM; ++i) x[i] ^= t;
+        return morton_index<NDIM>(x, nbits);  // the transposed index
+      }
+    }
+
+  }  // namespace detail
+
+  /// Keymap for the boxes of a \c 2^NDIM -ary refinement tree (binary tree for NDIM=1, quadtree for NDIM=2, octree
+  /// for NDIM=3) that keeps parents and children together
+  ///
+  /// A box is identified by its level \c n and translations \c l[d] in [0,2^n). The boxes of level
+  /// \c subtree_level are ordered along a space-filling curve and the curve is split into \c nranks contiguous
+  /// ranges, one per process; every box below \c subtree_level is owned by the owner of its ancestor on
+  /// \c subtree_level , every box above it by the owner of its first descendant on \c subtree_level . Hence whole
+  /// subtrees live on one process, and only the refinement steps across range boundaries and those above
+  /// \c subtree_level send messages. Choose \c subtree_level such that the level has enough boxes to balance the
+  /// load, i.e. \c 2^(NDIM*subtree_level) is a few times \c nranks or more; the default uses the deepest level
+  /// representable, i.e. partitions every level along the curve.
+  /// \tparam NDIM the number of dimensions
+  template <std::size_t NDIM>
+  class tree_keymap {
+   public:
+    static_assert(NDIM > 0 && NDIM <= 63);
+    /// the deepest subtree level for which curve indices fit into 63 bits
+    static constexpr int max_subtree_level = 63 / NDIM;
+
+    /// \param nranks the number of processes
+    /// \param subtree_level the level whose boxes are the roots of the subtrees that are kept on one process
+    /// \param curve the space-filling curve along which the boxes of \p subtree_level are partitioned
+    explicit tree_keymap(int nranks, int subtree_level = max_subtree_level,
+                         space_filling_curve curve = space_filling_curve::hilbert)
+        : nranks_(nranks), level_(subtree_level), curve_(curve) {
+      assert(nranks_ > 0 && level_ >= 0 && level_ <= max_subtree_level);
+    }
+
+    /// @return the process that owns the box with level \p n and translations \p l
+    template <typename Translation>
+    int operator()(long n, const std::array<Translation, NDIM> &l) const {
+      assert(n >= 0);
+      std::array<std::uint64_t, NDIM> x;
+      for (std::size_t d = 0; d != NDIM; ++d) {
+        const auto ld = static_cast<std::uint64_t>(l[d]);
+        x[d] = n > level_ ? ld >> (n - level_) : ld << (level_ - n);
+      }
+      const std::uint64_t index = curve_ == space_filling_curve::hilbert ? detail::hilbert_index<NDIM>(x, level_)
+                                                                         : detail::morton_index<NDIM>(x, level_);
+      // index * nranks / 2^nbits, using the leading 32 bits of index to avoid overflow
+      const int nbits = static_cast<int>(NDIM) * level_;
+      const std::uint64_t nr = static_cast<std::uint64_t>(nranks_);
+      if (nbits <= 32) return static_cast<int>((index * nr) >> nbits);
+      return static_cast<int>(((index >> (nbits - 32)) * nr) >> 32);
+    }
+
+    /// @return the process that owns the box with level \p n and translation \p l of a binary tree
+    template <std::size_t N = NDIM, typename = std::enable_if_t<N == 1>>
+    int operator()(long n, std::uint64_t l) const {
+      return (*this)(n, std::array<std::uint64_t, 1>{l});
+    }
+
+    int nranks() const { return nranks_; }
+    int subtree_level() const { return level_; }
+
+   private:
+    int nranks_;
+    int level_;
+    space_filling_curve curve_;
+  };
+
+  /// Composes an index map with a key projection, e.g. to map task (i,j,k) of a matrix multiply onto the
+  /// owner of tile (i,j):
+  /// \code
+  ///   op->set_keymap(ttg::project_keymap(ttg::block_cyclic_2d(P, Q),
+  ///                                      [](const Key<3> &key) { return std::make_tuple(key[0], key[1]); }));
+  /// \endcode
+  /// \param map an index map, e.g. block_cyclic_2d
+  /// \param projection maps a key onto the indices passed to \p map ; it returns either a single index or a
+  /// tuple-like object (std::tuple, std::pair, std::array) of indices
+  /// @return a keymap
+  template <typename Map, typename Projection>
+  auto project_keymap(Map &&map, Projection &&projection) {
+    return [map = std::forward<Map>(map), projection = std::forward<Projection>(projection)](const auto &key) -> int {
+      decltype(auto) indices = projection(key);
+      if constexpr (detail::is_tuple_like<std::decay_t<decltype(indices)>>::value)
+        return std::apply(map, indices);
+      else
+        return map(indices);
+    };
+  }
+
+}  // namespace ttg
+
+#endif  // TTG_UTIL_KEYMAPS_H
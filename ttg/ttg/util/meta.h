@@ -22,6 +22,13 @@ namespace ttg {
     template <typename T>
     using remove_cvr_t = std::remove_cv_t<std::remove_reference_t<T>>;
 
+    // moved_or_copied_t<T> is the type to bind a forwarding reference T&& to in order to consume it:
+    // std::decay_t<T>&& if it refers to an object that can be moved from, std::decay_t<T> (i.e. a copy) otherwise
+    template <typename T>
+    using moved_or_copied_t =
+        std::conditional_t<std::is_rvalue_reference_v<T &&> && !std::is_const_v<std::remove_reference_t<T>>,
+                           std::decay_t<T> &&, std::decay_t<T>>;
+
     template <typename Tuple, std::size_t N, typename Enabler = void>
     struct drop_first_n;
 
@@ -291,6 +298,53 @@ namespace ttg {
       template <typename Key, typename Value>
       using move_callback_t = typename move_callback<Key, Value>::type;
 
+      ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+      // send_fn_t<key,value> = void(*)(void *, const key&, const value&), protected against void key or value
+      // move_fn_t<key,value> = void(*)(void *, const key&, value&&), protected against void key or value
+      // the devirtualized counterparts of send_callback_t and move_callback_t, see In::set_direct_callback
+      ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+      template <typename Key, typename Value, typename Enabler = void>
+      struct send_fn;
+      template <typename Key, typename Value>
+      struct send_fn<Key, Value, std::enable_if_t<!is_void_v<Key> && !is_void_v<Value>>> {
+        using type = void (*)(void *, const Key &, const Value &);
+      };
+      template <typename Key, typename Value>
+      struct send_fn<Key, Value, std::enable_if_t<!is_void_v<Key> && is_void_v<Value>>> {
+        using type = void (*)(void *, const Key &);
+      };
+      template <typename Key, typename Value>
+      struct send_fn<Key, Value, std::enable_if_t<is_void_v<Key> && !is_void_v<Value>>> {
+        using type = void (*)(void *, const Value &);
+      };
+      template <typename Key, typename Value>
+      struct send_fn<Key, Value, std::enable_if_t<is_void_v<Key> && is_void_v<Value>>> {
+        using type = void (*)(void *);
+      };
+      template <typename Key, typename Value>
+      using send_fn_t = typename send_fn<Key, Value>::type;
+
+      template <typename Key, typename Value, typename Enabler = void>
+      struct move_fn;
+      template <typename Key, typename Value>
+      struct move_fn<Key, Value, std::enable_if_t<!is_void_v<Key> && !is_void_v<Value>>> {
+        using type = void (*)(void *, const Key &, Value &&);
+      };
+      template <typename Key, typename Value>
+      struct move_fn<Key, Value, std::enable_if_t<!is_void_v<Key> && is_void_v<Value>>> {
+        using type = void (*)(void *, const Key &);
+      };
+      template <typename Key, typename Value>
+      struct move_fn<Key, Value, std::enable_if_t<is_void_v<Key> && !is_void_v<Value>>> {
+        using type = void (*)(void *, Value &&);
+      };
+      template <typename Key, typename Value>
+      struct move_fn<Key, Value, std::enable_if_t<is_void_v<Key> && is_void_v<Value>>> {
+        using type = void (*)(void *);
+      };
+      template <typename Key, typename Value>
+      using move_fn_t = typename move_fn<Key, Value>::type;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // broadcast_callback_t<key,value> = std::function<void(const key&, value&&>, protected against void key or value
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
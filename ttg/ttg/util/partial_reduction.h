@@ -0,0 +1,130 @@
+#ifndef TTG_UTIL_PARTIAL_REDUCTION_H
+#define TTG_UTIL_PARTIAL_REDUCTION_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace ttg {
+
+  namespace detail {
+
+    /// @return a small integer that identifies the calling thread
+    inline std::size_t thread_index() {
+      static std::atomic<std::size_t> nthreads = 0;
+      static thread_local const std::size_t idx = nthreads++;
+      return idx;
+    }
+
+    /// Partial results of a reduction of a stream of values with a commutative reducer
+
+    /// Each thread reduces the values it contributes into its own partial result, hence contributions of different
+    /// threads to the same stream do not contend; the partial results are combined once the stream is complete.
+    /// Threads are mapped onto partial results round-robin, each partial result is guarded by a spinlock that is
+    /// uncontended unless there are more contributing threads than partial results.
+    ///
+    /// Contributions are reduced without holding the task they contribute to, hence the stream is completed, i.e. its
+    /// partial results are combined and the task released, by whoever is the last out: a contributor announces itself
+    /// with enter() while holding the task; the stream is closed once its goal is reached (see set_goal()) or it is
+    /// finalized (see close()); the caller that is told to do so, and wins try_complete() while holding the task,
+    /// completes the stream.
+    template <typename T>
+    class partial_reduction {
+      struct alignas(64) partial_t {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        std::optional<T> value;
+      };
+
+      static constexpr std::size_t closed = std::size_t(1) << (8 * sizeof(std::size_t) - 1);
+      static constexpr std::size_t completed = closed >> 1;
+
+      std::size_t npartials_;
+      std::unique_ptr<partial_t[]> partials_;
+      std::atomic<std::size_t> size_ = 0;
+      std::atomic<std::size_t> goal_;      // the number of values in the stream, 0 if not known yet
+      std::atomic<std::size_t> state_ = 0;  // # of contributors in flight, the closed and completed flags
+
+     public:
+      /// @param npartials the number of partial results, should be at least the number of contributing threads
+      /// @param goal the number of values in the stream, 0 if not known yet
+      explicit partial_reduction(std::size_t npartials, std::size_t goal = 0)
+          : npartials_(npartials > 0 ? npartials : 1)
+          , partials_(std::make_unique<partial_t[]>(npartials_))
+          , goal_(goal) {}
+
+      partial_reduction(const partial_reduction &) = delete;
+      partial_reduction &operator=(const partial_reduction &) = delete;
+
+      /// announces a contribution, to be followed by reduce(); the caller must hold the task
+      void enter() { state_.fetch_add(1, std::memory_order_acq_rel); }
+
+      /// reduces \p value into the partial result of the calling thread, ending the contribution announced by enter()
+      /// @return true if the caller is the last contributor out of the closed stream; it must then acquire the task and
+      ///         complete the stream if try_complete() returns true
+      template <typename Reducer>
+      bool reduce(Reducer &reducer, T &&value) {
+        auto &partial = partials_[thread_index() % npartials_];
+        while (partial.busy.test_and_set(std::memory_order_acquire))
+          ;
+        if (partial.value)
+          *partial.value = reducer(std::move(*partial.value), std::move(value));
+        else
+          partial.value.emplace(std::move(value));
+        partial.busy.clear(std::memory_order_release);
+        // N.B. seq_cst pairs with set_goal(): either this contribution sees the goal or set_goal() sees it
+        const std::size_t size = size_.fetch_add(1) + 1;
+        const std::size_t goal = goal_.load();
+        if (goal != 0 && size == goal) state_.fetch_or(closed, std::memory_order_acq_rel);
+        return state_.fetch_sub(1, std::memory_order_acq_rel) - 1 == closed;
+      }
+
+      /// sets the number of values in the stream to \p goal ; the caller must hold the task
+      /// @return true if the stream is complete and no contributions are in flight; the caller must then complete the
+      ///         stream if try_complete() returns true
+      bool set_goal(std::size_t goal) {
+        goal_.store(goal);
+        if (size_.load() != goal) return false;
+        return close();
+      }
+
+      /// closes the stream, e.g. when it is finalized; the caller must hold the task
+      /// @return true if no contributions are in flight; the caller must then complete the stream if try_complete()
+      ///         returns true
+      bool close() { return (state_.fetch_or(closed, std::memory_order_acq_rel) & ~(closed | completed)) == 0; }
+
+      /// claims the completion of the closed stream; the caller must hold the task
+      /// @return true if the stream is closed, no contributions are in flight and no one else has completed it, i.e. the
+      ///         caller must combine the partial results and release the task
+      bool try_complete() {
+        std::size_t expected = closed;
+        return state_.compare_exchange_strong(expected, closed | completed, std::memory_order_acq_rel);
+      }
+
+      /// @return the number of values reduced so far
+      std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+      /// combines the partial results; must not be called concurrently with reduce(), see try_complete()
+      /// @return the reduction of all values, or an empty optional if no values were reduced
+      template <typename Reducer>
+      std::optional<T> combine(Reducer &reducer) {
+        std::optional<T> result;
+        for (std::size_t p = 0; p != npartials_; ++p) {
+          auto &partial = partials_[p];
+          if (!partial.value) continue;
+          if (result)
+            *result = reducer(std::move(*result), std::move(*partial.value));
+          else
+            result = std::move(partial.value);
+          partial.value.reset();
+        }
+        return result;
+      }
+    };
+
+  }  // namespace detail
+
+}  // namespace ttg
+
+#endif  // TTG_UTIL_PARTIAL_REDUCTION_H
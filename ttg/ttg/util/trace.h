@@ -2,6 +2,16 @@
 #define TTG_TRACE_H
 
 namespace ttg {
+
+  /// true if tracing support is compiled in, i.e. if \c TTG_ENABLE_TRACE is defined (see the CMake option of the
+  /// same name); otherwise tracing() is a compile-time \c false, hence all tracing code in the per-task code paths is
+  /// dead and is eliminated by the compiler
+#ifdef TTG_ENABLE_TRACE
+  constexpr bool trace_enabled = true;
+#else
+  constexpr bool trace_enabled = false;
+#endif
+
   namespace detail {
     inline bool &trace_accessor() {
       static bool trace = false;
@@ -9,7 +19,14 @@ namespace ttg {
     }
   }  // namespace detail
 
-  inline bool tracing() { return detail::trace_accessor(); }
+  /// @return true if tracing is compiled in (see trace_enabled) and turned on by trace_on()
+  inline bool tracing() {
+    if constexpr (trace_enabled)
+      return detail::trace_accessor();
+    else
+      return false;
+  }
+  /// turns tracing on; has no effect unless trace_enabled is true
   inline void trace_on() { detail::trace_accessor() = true; }
   inline void trace_off() { detail::trace_accessor() = false; }
 
@@ -8,6 +8,7 @@
 
 #include "ttg/base/world.h"
 #include "ttg/base/keymap.h"
+#include "ttg/base/op.h"
 
 #include "ttg/fwd.h"
 
@@ -85,6 +86,9 @@ namespace ttg {
     }
   }
 
+  // defined here since World is incomplete in ttg/base/op.h
+  inline ttg::World OpBase::get_world() const { return get_default_world(); }
+
   inline int rank() {
     int me = -1;
 
@@ -18,7 +18,7 @@ class WrapOp
   using input_edges_type = typename baseT::input_edges_type;
   using output_edges_type = typename baseT::output_edges_type;
 
-  std::function<boost::callable_traits::function_type_t<funcT>> func;
+  std::decay_t<funcT> func;  // N.B. stored as is, not type-erased, so that it can be inlined into op()
 
   template <typename Key, typename Tuple>
   void call_func(Key &&key, Tuple &&args, output_terminalsT &out) {
@@ -100,7 +100,7 @@ class WrapOpArgs : public Op<keyT, output_terminalsT, WrapOpArgs<funcT, keyT, ou
   using input_edges_type = typename baseT::input_edges_type;
   using output_edges_type = typename baseT::output_edges_type;
 
-  std::function<boost::callable_traits::function_type_t<funcT>> func;
+  std::decay_t<funcT> func;  // N.B. stored as is, not type-erased, so that it can be inlined into op()
 
   template <typename Key, typename Tuple, std::size_t... S>
   void call_func(Key &&key, Tuple &&args_tuple, output_terminalsT &out, std::index_sequence<S...>) {